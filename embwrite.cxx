@@ -31,9 +31,12 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include<embwrite.hxx>
+#include<algorithm>
 #include<cassert>
 #include<cmath>
+#include<cstdio>
 #include<list>
+#include<string>
 #include<vector>
 #include<stdexcept>
 
@@ -53,6 +56,12 @@
 #include<libembroidery/emb-color.h>
 #include<libembroidery/emb-thread.h>
 #include<libembroidery/emb-pattern.h>
+#include<libembroidery/emb-reader-writer.h>
+#include<libembroidery/thread-color.h>
+
+
+static const float SATIN_MIN_SEGMENT = 1e-6; /* squared length */
+static const float SATIN_MITER_LIMIT = 3.0;  /* in half width */
 
 
 struct connect{
@@ -203,8 +212,43 @@ public:
 /*
  * Default constructor
  */
-EmbroideryWriter::EmbroideryWriter()
+EmbroideryWriter::EmbroideryWriter() :
+  color(0x000000), usecatalog(false), catalog(Isacord_Polyester)
+{
+}
+
+
+/*
+ * Set color (0xRRGGBB) of stitches added after this
+ */
+void EmbroideryWriter::set_color(unsigned int rgb)
 {
+  color = rgb & 0xFFFFFF;
+}
+
+
+/*
+ * Use nearest thread of catalog instead of exact colors
+ */
+void EmbroideryWriter::set_thread_catalog(ThreadBrand brand)
+{
+  usecatalog = true;
+  catalog = brand;
+}
+
+
+/*
+ * Thread color used for stitches of color rgb
+ */
+unsigned int EmbroideryWriter::thread_color(unsigned int rgb) const
+{
+  if( usecatalog ){
+    unsigned int nearest = threadColorNearest(0xFF000000 | rgb, catalog);
+    if( 0!=nearest ){
+      return nearest & 0xFFFFFF;
+    }
+  }
+  return rgb;
 }
 
 
@@ -250,6 +294,115 @@ EmbroideryWriter::make_points_on_bezier(const float* bezierpts,
 }
 
 
+/*
+ * Make points on dashed Bezier curve
+ *
+ * Walks the curve once like make_points_on_bezier() and splits it into
+ * one point list per dash. Dashes and gaps alternate through dasharray,
+ * an odd count of lengths is repeated as SVG does. dashoffset is the
+ * distance into the dash pattern at the start of the path.
+ */
+std::vector<std::vector<math::vector2d> >
+EmbroideryWriter::make_dashes_on_bezier(const float* bezierpts,
+                                        int npts, float pitch,
+                                        const float* dasharray, int ndash,
+                                        float dashoffset)
+{
+  std::vector<std::vector<math::vector2d> > dashes;
+  if( 0>=ndash ){
+    dashes.push_back(make_points_on_bezier(bezierpts, npts, pitch));
+    return dashes;
+  }
+
+  /* find the dash at the start of the path */
+  float period = 0.0;
+  for(int d=0; d<ndash; ++d){
+    period += dasharray[d];
+  }
+  if( 0!=ndash%2 ){
+    period *= 2.0;
+  }
+  float offset = fmod(dashoffset, period);
+  if( 0.0>offset ){
+    offset += period;
+  }
+  int dash = 0;
+  bool on = true;
+  while( dasharray[dash] <= offset ){
+    offset -= dasharray[dash];
+    dash = (dash+1)%ndash;
+    on = !on;
+  }
+  float dashleft = dasharray[dash] - offset; /* distance to end of dash */
+  float stitchleft = pitch;                  /* distance to next stitch */
+
+  std::vector<math::vector2d> points;
+  math::vector2d lastpt;
+  if( on && 1<npts ){
+    points.push_back(math::vector2d(&bezierpts[0]));
+  }
+
+  for(int i=0; i<npts-1; i+=3) {
+    math::vector2d p0(&bezierpts[i*2  ]);
+    math::vector2d p1(&bezierpts[i*2+2]);
+    math::vector2d p2(&bezierpts[i*2+4]);
+    math::vector2d p3(&bezierpts[i*2+6]);
+    lastpt = p3;
+
+    /* create bezier curve */
+    CubicBezier<float,2> curve(p0, p1, p2, p3);
+
+    /* go to next stitch or dash end, whichever comes first */
+    float t=0.0;
+    for(;;){
+      float step = (on && stitchleft < dashleft) ? stitchleft : dashleft;
+      float remain = curve.move_on_curve(t, step);
+      dashleft -= step - remain;
+      stitchleft -= step - remain;
+      if( 0.0<remain ){
+        /* continue on next curve */
+        break;
+      }
+
+      if( 0.0>=dashleft ){
+        if( on ){
+          /* end of dash */
+          points.push_back( curve.curve(t) );
+          if( 1<points.size() ){
+            dashes.push_back(points);
+          }
+          points.clear();
+        }else{
+          /* start of dash */
+          points.push_back( curve.curve(t) );
+          stitchleft = pitch;
+        }
+        on = !on;
+        dash = (dash+1)%ndash;
+        dashleft = dasharray[dash];
+      }else{
+        /* stitch in dash */
+        points.push_back( curve.curve(t) );
+        stitchleft = pitch;
+      }
+    }
+  }
+
+  if( on && !points.empty() ){
+    if( 0.25*pitch > stitchleft && 1<points.size() ){
+      /* move last point */
+      points.back() = lastpt;
+    }else{
+      /* add one more point at last */
+      points.push_back(lastpt);
+    }
+    dashes.push_back(points);
+  }
+
+  return dashes;
+}
+
+
 /*
  * Check if embroidery is empty
  */
@@ -260,9 +413,10 @@ bool EmbroideryWriter::is_empty() const
 
 
 /*
- * Optimize stitch order to minimize jumps
+ * Reorder and reverse stitch segments to minimize jumps
  */
-void EmbroideryWriter::optimize_order()
+static void
+optimize_segments(std::vector<std::vector<math::vector2d> >& stitches)
 {
   if( 1>=stitches.size() ){
     /* only one stitch, no optimization needed */
@@ -379,6 +533,49 @@ void EmbroideryWriter::optimize_order()
       newstitches.push_back(stitches[it->first]);
     }
   }
+  stitches.swap(newstitches);
+}
+
+
+/*
+ * Append stitches of other writer
+ */
+void EmbroideryWriter::append(const EmbroideryWriter& other)
+{
+  stitches.insert(stitches.end(), other.stitches.begin(), other.stitches.end());
+  colors.insert(colors.end(), other.colors.begin(), other.colors.end());
+}
+
+
+/*
+ * Optimize stitch order to minimize color changes and jumps
+ */
+void EmbroideryWriter::optimize_order()
+{
+  /* one block for each thread, in order of first appearance */
+  std::vector<unsigned int> blockcolors;
+  std::vector<std::vector<std::vector<math::vector2d> > > blocks;
+  for(size_t i=0; i<stitches.size(); ++i){
+    unsigned int thread = thread_color(colors[i]);
+    size_t b = 0;
+    while( b<blockcolors.size() && blockcolors[b]!=thread ){
+      ++b;
+    }
+    if( b==blockcolors.size() ){
+      blockcolors.push_back(thread);
+      blocks.push_back(std::vector<std::vector<math::vector2d> >());
+    }
+    blocks[b].push_back(stitches[i]);
+  }
+
+  /* minimize jumps in each block */
+  stitches.clear();
+  colors.clear();
+  for(size_t b=0; b<blocks.size(); ++b){
+    optimize_segments(blocks[b]);
+    stitches.insert(stitches.end(), blocks[b].begin(), blocks[b].end());
+    colors.insert(colors.end(), blocks[b].size(), blockcolors[b]);
+  }
 }
 
 
@@ -388,38 +585,69 @@ void EmbroideryWriter::optimize_order()
 void EmbroideryWriter::write(const char* filename)
   const throw(std::runtime_error)
 {
-  EmbColor black = { 0, 0, 0 };
-  EmbThread thread = { black, "Black", "900" };
+  std::list<std::string> numbers; /* catalog numbers referred by threads */
+  const EmbReaderWriter* writer = embReaderWriter_getByFileName(filename);
   EmbPattern* pat;
 
-  pat = embPattern_create();
-
-  /* set thread & color */
-  embPattern_addThread(pat, thread);
+  /* keep stitches in 0.1mm integers if the format is written from those */
+  if( writer && (writer->fixedPoint & EMB_RW_FIXED_WRITE) ){
+    pat = embPattern_createFixed();
+  }else{
+    pat = embPattern_create();
+  }
   embPattern_changeColor(pat, 0);
 
   for(size_t i=0; i<stitches.size(); ++i){
     const std::vector<math::vector2d>& stitchsegment = stitches[i];
+    unsigned int thread = thread_color(colors[i]);
+    bool newthread = ( 0==i || thread!=thread_color(colors[i-1]) );
+
+    if( newthread ){
+      /* set thread & color */
+      EmbThread t;
+      t.color.r = (thread>>16) & 0xFF;
+      t.color.g = (thread>> 8) & 0xFF;
+      t.color.b = (thread    ) & 0xFF;
+      t.description = "";
+      t.catalogNumber = "";
+      if( usecatalog ){
+        char number[16];
+        int num = threadColorNum(0xFF000000 | thread, catalog);
+        t.description = threadColorName(0xFF000000 | thread, catalog);
+        if( 0<=num ){
+          snprintf(number, sizeof(number), "%d", num);
+          numbers.push_back(number);
+          t.catalogNumber = numbers.back().c_str();
+        }
+      }
+      embPattern_addThread(pat, t);
+    }
 
     for(size_t j=0; j<stitchsegment.size(); ++j){
       math::vector2d pos = stitchsegment[j];
       if( 0==j ){
         if( 0<i ){
           /* cut thread */
-          embPattern_addStitchAbs(pat, pos[0], -pos[1], TRIM, 0);
+          embPattern_addStitchAbs(pat, pos[0], pos[1], TRIM, 0);
+          if( newthread ){
+            /* stop to change thread */
+            embPattern_addStitchRel(pat, 0.0, 0.0, STOP, 1);
+          }
         }
         /* jump to new segment */
-        embPattern_addStitchAbs(pat, pos[0], -pos[1], JUMP, 0);
+        embPattern_addStitchAbs(pat, pos[0], pos[1], JUMP, 0);
       }
-      embPattern_addStitchAbs(pat, pos[0], -pos[1], NORMAL, 0);
+      embPattern_addStitchAbs(pat, pos[0], pos[1], NORMAL, 0);
     }
   }
   embPattern_addStitchRel(pat, 0.0, 0.0, END, 0);
 
   if( ! embPattern_write(pat, filename) ){
     /* write failed */
+    embPattern_free(pat);
     throw std::runtime_error("Failed to write embroidery file.");
   }  
+  embPattern_free(pat);
 }
 
 
@@ -458,9 +686,11 @@ EmbroideryWriter::add_single_stitch(const std::vector<math::vector2d>& points,
     }
 
     stitches.push_back(stitchsegment);
+    colors.push_back(color);
   }else{
     /* no star, stitches are points only*/
     stitches.push_back(points);
+    colors.push_back(color);
   }
 }
 
@@ -505,6 +735,98 @@ EmbroideryWriter::add_tripple_stitch(const std::vector<math::vector2d>& points,
   stitchsegment.insert(stitchsegment.end(), points.begin(), points.end());
 
   stitches.push_back(stitchsegment);
+  colors.push_back(color);
+}
+
+
+/*
+ * paths as satin columns
+ *
+ * Sides of a column are its center line offset by half width, with
+ * mitred joints as embSatinOutline_generateSatinOutline() makes them,
+ * but parallel segments are joined without intersecting lines. Stitches
+ * zigzag between the sides, spacing apart on each side. All columns go
+ * through the same side buffers.
+ */
+void
+EmbroideryWriter::add_satin_stitch(
+  const std::vector<std::vector<math::vector2d> >& columns,
+  float width, float spacing)
+{
+  const float halfwidth = 0.5*width;
+  std::vector<math::vector2d> center;
+  std::vector<math::vector2d> side1;
+  std::vector<math::vector2d> side2;
+  std::vector<float> length; /* along center line */
+
+  for(size_t c=0; c<columns.size(); ++c){
+    /* drop repeated points, a segment needs direction */
+    center.clear();
+    for(size_t i=0; i<columns[c].size(); ++i){
+      if( center.empty()
+          || SATIN_MIN_SEGMENT < (columns[c][i]-center.back()).square_norm() ){
+        center.push_back(columns[c][i]);
+      }
+    }
+    size_t n = center.size();
+    if( 2>n ){
+      /* Too short path */
+      continue;
+    }
+
+    /* outline */
+    side1.resize(n);
+    side2.resize(n);
+    length.resize(n);
+    length[0] = 0.0;
+    math::vector2d prevnormal;
+    for(size_t i=0; i<n; ++i){
+      math::vector2d normal = prevnormal;
+      if( i+1<n ){
+        math::vector2d d = center[i+1] - center[i];
+        length[i+1] = length[i] + d.norm();
+        normal = math::vector2d(-d[1], d[0]).normalize(); /* left */
+      }
+      math::vector2d miter = normal;
+      float scale = 1.0;
+      if( 0<i && i+1<n ){
+        miter = prevnormal + normal;
+        if( 1e-6 < miter.square_norm() ){
+          miter = miter.normalize();
+          scale = std::min(1.0f/(miter*normal), SATIN_MITER_LIMIT);
+        }else{
+          /* turns back */
+          miter = normal;
+        }
+      }
+      side1[i] = center[i] + miter*(halfwidth*scale);
+      side2[i] = center[i] - miter*(halfwidth*scale);
+      prevnormal = normal;
+    }
+
+    /* zigzag, half spacing forward on each stitch */
+    int steps = (int)ceil(2.0*length[n-1]/spacing);
+    if( 1>steps ){
+      steps = 1;
+    }
+    std::vector<math::vector2d> stitchsegment;
+    stitchsegment.reserve(steps+2);
+    size_t j = 0;
+    for(int k=0; k<=steps; ++k){
+      float l = length[n-1]*k/steps;
+      while( j+2<n && length[j+1]<l ){
+        ++j;
+      }
+      float t = (l-length[j]) / (length[j+1]-length[j]);
+      const std::vector<math::vector2d>& side = (0==k%2) ? side1 : side2;
+      stitchsegment.push_back( side[j] + (side[j+1]-side[j])*t );
+    }
+    /* cover the end on both sides */
+    stitchsegment.push_back( (0==steps%2) ? side2[n-1] : side1[n-1] );
+
+    stitches.push_back(stitchsegment);
+    colors.push_back(color);
+  }
 }
 
 
@@ -516,5 +838,6 @@ void EmbroideryWriter::add_star(const math::vector2d& p, float starsize)
     std::vector<math::vector2d> star
       = make_star(p, 0.5*starsize);
   stitches.push_back(star);
+  colors.push_back(color);
 }
 
@@ -39,17 +39,28 @@
 #include<mathtransm.hxx>
 #include<cubicbezier.hxx>
 
+#include<libembroidery/thread-color.h>
 
 
 class EmbroideryWriter
 {
 private:
   std::vector<std::vector<math::vector2d> > stitches;
+  std::vector<unsigned int> colors; /* 0xRRGGBB of each stitch segment */
+  unsigned int color;               /* color of segments added next */
+  bool usecatalog;
+  ThreadBrand catalog;
+
+  unsigned int thread_color(unsigned int rgb) const;
 
 public:
   EmbroideryWriter();
 
+  void set_color(unsigned int rgb);
+  void set_thread_catalog(ThreadBrand brand);
+
   bool is_empty() const;
+  void append(const EmbroideryWriter& other);
   void optimize_order();
   void write(const char* filename) const throw(std::runtime_error);
  
@@ -59,11 +70,16 @@ public:
   void add_tripple_stitch(const std::vector<math::vector2d>& points,
                           float starsize,
                           bool startstar, bool endstar);
+  void add_satin_stitch(const std::vector<std::vector<math::vector2d> >& columns,
+                        float width, float spacing);
   void add_star(const math::vector2d& p, float starsize);
  
 
   static std::vector<math::vector2d>
   make_points_on_bezier(const float* bezierpts, int npts, float pitch);
+  static std::vector<std::vector<math::vector2d> >
+  make_dashes_on_bezier(const float* bezierpts, int npts, float pitch,
+                        const float* dasharray, int ndash, float dashoffset);
 
 }; /* end of class EmbroideryWriter */
 
@@ -347,9 +347,9 @@ static FzWires parse_fritzing_wires() throw(std::runtime_error)
         if( ! ( std::isnan(x ) || std::isnan(y ) ||
                 std::isnan(x1) || std::isnan(y1) ||
                 std::isnan(x2) || std::isnan(y2) ) ){
-          /* valid wire node, make line */
-          math::vector2d p1(fz2mm(x+x1), fz2mm(y+y1));
-          math::vector2d p2(fz2mm(x+x2), fz2mm(y+y2));
+          /* valid wire node, make line (Y axis of embroidery is upward) */
+          math::vector2d p1(fz2mm(x+x1), -fz2mm(y+y1));
+          math::vector2d p2(fz2mm(x+x2), -fz2mm(y+y2));
 
           wires.add_wire(p1, p2, connectboard[0], connectboard[1]);
         }
@@ -14,9 +14,18 @@ typedef struct EmbColor_
     unsigned char b;
 } EmbColor;
 
+/* CIELAB color with the D65 white point */
+typedef struct EmbColorLab_
+{
+    double l;
+    double a;
+    double b;
+} EmbColorLab;
+
 extern EMB_PUBLIC EmbColor EMB_CALL embColor_make(unsigned char r, unsigned char g, unsigned char b);
 extern EMB_PUBLIC EmbColor* EMB_CALL embColor_create(unsigned char r, unsigned char g, unsigned char b);
 extern EMB_PUBLIC EmbColor EMB_CALL embColor_fromHexStr(char* val);
+extern EMB_PUBLIC EmbColorLab EMB_CALL embColor_toLab(EmbColor color);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,133 @@
+#include "emb-context.h"
+#include "emb-logging.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GNUC__)
+    #define EMB_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+    #define EMB_THREAD_LOCAL __declspec(thread)
+#else
+    #define EMB_THREAD_LOCAL /* no thread-local storage, bind contexts from one thread only */
+#endif
+
+static void* embContext_defaultAlloc(void* userData, size_t size)
+{
+    (void)userData;
+    return malloc(size);
+}
+
+static void embContext_defaultFree(void* userData, void* ptr)
+{
+    (void)userData;
+    free(ptr);
+}
+
+static void embContext_defaultLog(void* userData, int level, const char* message)
+{
+    (void)userData;
+    if(level == EMB_LOG_WARNING) fputs("WARNING: ", stdout);
+    else if(level == EMB_LOG_ERROR) fputs("ERROR: ", stdout);
+    fputs(message, stdout);
+}
+
+/* Used when no context is bound. It never collects errors, so it is never written to and can be shared by all threads. */
+static EmbContext embContextDefault =
+{
+    embContext_defaultAlloc,
+    embContext_defaultFree,
+    0,
+    embContext_defaultLog,
+    0,
+    EMB_LOG_INFO,
+    0,
+    0,
+    0,
+    0,
+    0
+};
+
+/* The context bound by the innermost read or write running on this thread */
+static EMB_THREAD_LOCAL EmbContext* embContextBound = 0;
+
+/*! Returns a context that allocates with malloc(), logs messages of EMB_LOG_INFO and above to stdout
+ *  and collects errors. Free the collected errors with embContext_clearErrors(). */
+EmbContext embContext_init(void)
+{
+    EmbContext context = embContextDefault;
+    context.collectErrors = 1;
+    return context;
+}
+
+/*! Allocates \a size bytes with the allocator of \a context. Returns 0 on failure. */
+void* embContext_allocate(EmbContext* context, size_t size)
+{
+    return context->alloc(context->allocUserData, size);
+}
+
+/*! Frees memory returned by embContext_allocate() with the same \a context. */
+void embContext_deallocate(EmbContext* context, void* ptr)
+{
+    if(ptr) context->free(context->allocUserData, ptr);
+}
+
+/*! Returns the error messages collected by \a context, one per line, or an empty string. */
+const char* embContext_errors(const EmbContext* context)
+{
+    return context->errors ? context->errors : "";
+}
+
+/*! Forgets the errors collected by \a context and frees their storage. */
+void embContext_clearErrors(EmbContext* context)
+{
+    embContext_deallocate(context, context->errors);
+    context->errors = 0;
+    context->errorsLength = 0;
+    context->errorsCapacity = 0;
+    context->errorCount = 0;
+}
+
+/* Appends \a message to the errors of \a context if it collects them */
+void embContext_addError(EmbContext* context, const char* message)
+{
+    size_t length = strlen(message);
+    int newline = !length || message[length - 1] != '\n';
+
+    if(!context->collectErrors) return;
+    if(context->errorsLength + length + newline + 1 > context->errorsCapacity)
+    {
+        size_t capacity = context->errorsCapacity ? context->errorsCapacity : 256;
+        char* errors = 0;
+        while(capacity < context->errorsLength + length + newline + 1) capacity *= 2;
+        errors = (char*)embContext_allocate(context, capacity);
+        if(!errors) return; /* keep what has been collected */
+        if(context->errors) memcpy(errors, context->errors, context->errorsLength);
+        embContext_deallocate(context, context->errors);
+        context->errors = errors;
+        context->errorsCapacity = capacity;
+    }
+    memcpy(context->errors + context->errorsLength, message, length);
+    context->errorsLength += length;
+    if(newline) context->errors[context->errorsLength++] = '\n';
+    context->errors[context->errorsLength] = '\0';
+    context->errorCount++;
+}
+
+/*! Returns the context bound to the calling thread, or the default context if none is bound. */
+EmbContext* embContext_current(void)
+{
+    return embContextBound ? embContextBound : &embContextDefault;
+}
+
+/*! Binds \a context to the calling thread and returns the previously bound context.
+ *  Pass the returned value back to restore it. A null \a context unbinds. */
+EmbContext* embContext_bind(EmbContext* context)
+{
+    EmbContext* previous = embContextBound;
+    embContextBound = context;
+    return previous;
+}
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
@@ -0,0 +1,62 @@
+/*! @file emb-context.h */
+#ifndef EMB_CONTEXT_H
+#define EMB_CONTEXT_H
+
+#include <stddef.h>
+
+#include "api-start.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void* (*EmbAllocFunc)(void* userData, size_t size);
+typedef void (*EmbFreeFunc)(void* userData, void* ptr);
+typedef void (*EmbLogFunc)(void* userData, int level, const char* message);
+
+/* Per-call state for reads and writes.
+ *
+ * libembroidery keeps no mutable global state, so different patterns may be read and written
+ * concurrently on different threads. A context is bound to the calling thread for the duration of
+ * embPattern_readWithContext() or embPattern_writeWithContext() and must not be used by two calls
+ * at once. Calls made without a context share a read-only default that logs to stdout and does not
+ * collect errors. The callbacks may be invoked from every thread that uses the context and must be
+ * thread-safe if they share data.
+ *
+ * The allocator provides transient buffers that are released before the call returns, such as a
+ * whole input file. Pattern data is always allocated with malloc() so embPattern_free() can free it. */
+typedef struct EmbContext_
+{
+    EmbAllocFunc alloc; /* defaults to malloc() */
+    EmbFreeFunc free;   /* defaults to free() */
+    void* allocUserData;
+    EmbLogFunc log;     /* defaults to printing on stdout */
+    void* logUserData;
+    int logLevel;       /* lowest EMB_LOG_* level passed to log, checked before a message is formatted */
+
+    int collectErrors;  /* keep every EMB_LOG_ERROR message, see embContext_errors() */
+    int errorCount;
+    char* errors;       /* collected messages, each ending with a newline */
+    size_t errorsLength;
+    size_t errorsCapacity;
+} EmbContext;
+
+extern EMB_PUBLIC EmbContext EMB_CALL embContext_init(void);
+
+extern EMB_PUBLIC void* EMB_CALL embContext_allocate(EmbContext* context, size_t size);
+extern EMB_PUBLIC void EMB_CALL embContext_deallocate(EmbContext* context, void* ptr);
+
+extern EMB_PUBLIC const char* EMB_CALL embContext_errors(const EmbContext* context);
+extern EMB_PUBLIC void EMB_CALL embContext_clearErrors(EmbContext* context);
+extern EMB_PRIVATE void EMB_CALL embContext_addError(EmbContext* context, const char* message);
+
+extern EMB_PUBLIC EmbContext* EMB_CALL embContext_current(void);
+extern EMB_PUBLIC EmbContext* EMB_CALL embContext_bind(EmbContext* context);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#include "api-stop.h"
+
+#endif /* EMB_CONTEXT_H */
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
@@ -1,111 +1,198 @@
 #include "emb-format.h"
 #include "emb-logging.h"
+#include "formats.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 
+#ifdef ARDUINO /* ARDUINO TODO: This is temporary. Remove when complete. */
+#define EMB_RW(r, w) { 0, 0, 0 }
+#define EMB_RWF(r, w) { 0, 0, 0 }
+#define EMB_RWFR(r, w) { 0, 0, 0 }
+#else /* ARDUINO TODO: This is temporary. Remove when complete. */
+#define EMB_RW(r, w) { r, w, 0 }
+#define EMB_RWF(r, w) { r, w, EMB_RW_FIXED_READ | EMB_RW_FIXED_WRITE } /* both work on fixed-point patterns */
+#define EMB_RWFR(r, w) { r, w, EMB_RW_FIXED_READ }                     /* only the reader does */
+#endif /* ARDUINO TODO: This is temporary. Remove when complete. */
+
+/* TODO: This list needs reviewed in case some stitch formats also can contain object data (EMBFORMAT_STCHANDOBJ). */
+/* NOTE: entries must stay sorted by extension (strcmp order), embFormat_getByFileName() does a binary search. */
+static const EmbFormat embFormatTable[] =
+{
+    { ".100", "Toyota Embroidery Format",           'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(read100, write100),   0,                     0 },
+    { ".10o", "Toyota Embroidery Format",           'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(read10o, write10o),   0,                     0 },
+    { ".art", "Bernina Embroidery Format",          ' ', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readArt, writeArt),   0,                     0 },
+    { ".bmc", "Bitmap Cache Embroidery Format",     ' ', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readBmc, writeBmc),   0,                     0 },
+    { ".bro", "Bits & Volts Embroidery Format",     'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readBro, writeBro),   0,                     0 },
+    { ".cnd", "Melco Embroidery Format",            ' ', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readCnd, writeCnd),   0,                     0 },
+    { ".col", "Embroidery Thread Color Format",     'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readCol, writeCol),   0,                     0 },
+    { ".csd", "Singer Embroidery Format",           'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readCsd, writeCsd),   0,                     0 },
+    { ".csv", "Comma Separated Values Format",      'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readCsv, writeCsv),   0,                     0 },
+    { ".dat", "Barudan Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readDat, writeDat),   0,                     0 },
+    { ".dem", "Melco Embroidery Format",            ' ', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readDem, writeDem),   0,                     0 },
+    { ".dsb", "Barudan Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readDsb, writeDsb),   0,                     0 },
+    { ".dst", "Tajima Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RWF(readDst, writeDst),  "LA:",                 3 },
+    { ".dsz", "ZSK USA Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readDsz, writeDsz),   0,                     0 },
+    { ".dxf", "Drawing Exchange Format",            ' ', ' ', EMBFORMAT_OBJECTONLY,  EMB_RW(readDxf, writeDxf),   0,                     0 },
+    { ".edr", "Embird Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readEdr, writeEdr),   0,                     0 },
+    { ".emd", "Elna Embroidery Format",             'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readEmd, writeEmd),   0,                     0 },
+    { ".exp", "Melco Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY,  { readExp, writeExp, 0 },    0,                     0 },
+    { ".exy", "Eltac Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readExy, writeExy),   0,                     0 },
+    { ".eys", "Sierra Expanded Embroidery Format",  ' ', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readEys, writeEys),   0,                     0 },
+    { ".fxy", "Fortron Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readFxy, writeFxy),   0,                     0 },
+    { ".gc",  "Smoothie G-Code Format",             ' ', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readGc, writeGc),     0,                     0 },
+    { ".gnc", "Great Notions Embroidery Format",    ' ', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readGnc, writeGnc),   0,                     0 },
+    { ".gt",  "Gold Thread Embroidery Format",      'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readGt, writeGt),     0,                     0 },
+    { ".hus", "Husqvarna Viking Embroidery Format", 'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RWF(readHus, writeHus),  "\x5B\xAF\xC8\x00",    4 },
+    { ".inb", "Inbro Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readInb, writeInb),   0,                     0 },
+    { ".inf", "Embroidery Color Format",            'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readInf, writeInf),   0,                     0 },
+    { ".jef", "Janome Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RWF(readJef, writeJef),  0,                     0 },
+    { ".ksm", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readKsm, writeKsm),   0,                     0 },
+    { ".max", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readMax, writeMax),   0,                     0 },
+    { ".mit", "Mitsubishi Embroidery Format",       'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readMit, writeMit),   0,                     0 },
+    { ".new", "Ameco Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readNew, writeNew),   0,                     0 },
+    { ".ofm", "Melco Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readOfm, writeOfm),   0,                     0 },
+    { ".pcd", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readPcd, writePcd),   0,                     0 },
+    { ".pcm", "Pfaff Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readPcm, writePcm),   0,                     0 },
+    { ".pcq", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readPcq, writePcq),   0,                     0 },
+    { ".pcs", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readPcs, writePcs),   0,                     0 },
+    { ".pec", "Brother Embroidery Format",          'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RWFR(readPec, writePec), "#PEC",                4 },
+    { ".pel", "Brother Embroidery Format",          ' ', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readPel, writePel),   0,                     0 },
+    { ".pem", "Brother Embroidery Format",          ' ', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readPem, writePem),   0,                     0 },
+    { ".pes", "Brother Embroidery Format",          'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RWFR(readPes, writePes), "#PES",                4 },
+    { ".phb", "Brother Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readPhb, writePhb),   0,                     0 },
+    { ".phc", "Brother Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readPhc, writePhc),   0,                     0 },
+    { ".plt", "AutoCAD Plot Drawing Format",        'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readPlt, writePlt),   0,                     0 },
+    { ".rgb", "RGB Embroidery Format",              'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readRgb, writeRgb),   0,                     0 },
+    { ".sew", "Janome Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readSew, writeSew),   0,                     0 },
+    { ".shv", "Husqvarna Viking Embroidery Format", 'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readShv, writeShv),   0,                     0 },
+    { ".sst", "Sunstar Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readSst, writeSst),   0,                     0 },
+    { ".stx", "Data Stitch Embroidery Format",      'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readStx, writeStx),   0,                     0 },
+    { ".svg", "Scalable Vector Graphics",           'U', 'U', EMBFORMAT_OBJECTONLY,  EMB_RW(readSvg, writeSvg),   "<svg",                4 },
+    { ".t01", "Pfaff Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readT01, writeT01),   0,                     0 },
+    { ".t09", "Pfaff Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readT09, writeT09),   0,                     0 },
+    { ".tap", "Happy Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readTap, writeTap),   0,                     0 },
+    { ".thr", "ThredWorks Embroidery Format",       'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readThr, writeThr),   "rht",                 3 },
+    { ".txt", "Text File",                          ' ', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readTxt, writeTxt),   0,                     0 },
+    { ".u00", "Barudan Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readU00, writeU00),   0,                     0 },
+    { ".u01", "Barudan Embroidery Format",          ' ', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readU01, writeU01),   0,                     0 },
+    { ".vip", "Pfaff Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readVip, writeVip),   "\x5D\xFC\x90\x01",    4 },
+    { ".vp3", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readVp3, writeVp3),   "%vsm%",               5 },
+    { ".xxx", "Singer Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY,  EMB_RW(readXxx, writeXxx),   0,                     0 },
+    { ".zsk", "ZSK USA Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY,  EMB_RW(readZsk, writeZsk),   0,                     0 },
+};
+
+#define EMB_FORMAT_COUNT ((int)(sizeof(embFormatTable) / sizeof(embFormatTable[0])))
+
+/**************************************************/
+/* EmbFormat                                      */
+/**************************************************/
+
+/*! Returns the number of formats in the built-in registry. */
+int embFormat_count(void)
+{
+    return EMB_FORMAT_COUNT;
+}
+
+/*! Returns the registry entry at \a index, or 0 if \a index is out of range. */
+const EmbFormat* embFormat_getByIndex(int index)
+{
+    if(index < 0 || index >= EMB_FORMAT_COUNT) return 0;
+    return &embFormatTable[index];
+}
+
+/*! Returns the registry entry matching the extension of \a fileName
+ *  (case insensitive), or 0 if the extension is missing or unknown.
+ *  Does not allocate. */
+const EmbFormat* embFormat_getByFileName(const char* fileName)
+{
+    const char* dotPos = 0;
+    char ending[2 + EMBFORMAT_MAXEXT];
+    int i, low, high, mid, cmp;
+
+    if(!fileName) { embLog_error("emb-format.c embFormat_getByFileName(), fileName argument is null\n"); return 0; }
+
+    dotPos = strrchr(fileName, '.');
+    if(!dotPos) return 0;
+    for(i = 0; dotPos[i] != '\0'; i++)
+    {
+        if(i > EMBFORMAT_MAXEXT) return 0;
+        ending[i] = (char)tolower(dotPos[i]);
+    }
+    ending[i] = '\0';
+
+    low = 0;
+    high = EMB_FORMAT_COUNT - 1;
+    while(low <= high)
+    {
+        mid = (low + high) / 2;
+        cmp = strcmp(ending, embFormatTable[mid].extension);
+        if(cmp == 0) return &embFormatTable[mid];
+        if(cmp < 0) high = mid - 1;
+        else        low = mid + 1;
+    }
+    return 0;
+}
+
+/*! Identifies a file from its first \a length bytes in \a data by
+ *  matching the magic bytes of formats that have them. Reading
+ *  EMBFORMAT_MAXMAGIC bytes is enough. Returns 0 if nothing matches. */
+const EmbFormat* embFormat_getByContents(const unsigned char* data, int length)
+{
+    int i;
+
+    if(!data) { embLog_error("emb-format.c embFormat_getByContents(), data argument is null\n"); return 0; }
+
+    for(i = 0; i < EMB_FORMAT_COUNT; i++)
+    {
+        const EmbFormat* format = &embFormatTable[i];
+        if(format->magicLength > 0 && format->magicLength <= length &&
+           !memcmp(data, format->magic, format->magicLength))
+        {
+            return format;
+        }
+    }
+    return 0;
+}
+
 /**************************************************/
 /* EmbFormatList                                  */
 /**************************************************/
 
+/*! Returns a newly allocated list copy of the format registry.
+ *  Prefer embFormat_count() and embFormat_getByIndex(), which do not allocate. */
 EmbFormatList* embFormatList_create()
 {
     EmbFormatList* firstFormat = 0;
+    EmbFormatList* lastFormat = 0;
+    EmbFormatList* heapFormat = 0;
+    int i;
 
-    /* TODO: This list needs reviewed in case some stitch formats also can contain object data (EMBFORMAT_STCHANDOBJ). */
-
-    EmbFormatList* heapFormatList = (EmbFormatList*)malloc(sizeof(EmbFormatList));
-    if(!heapFormatList) { embLog_error("emb-format.c embFormatList_create(), cannot allocate memory for heapFormatList\n"); return 0; }
-    heapFormatList->extension = ".10o";
-    heapFormatList->description = "Toyota Embroidery Format";
-    heapFormatList->reader = 'U';
-    heapFormatList->writer = ' ';
-    heapFormatList->type = EMBFORMAT_STITCHONLY;
-    heapFormatList->next = 0;
-
-    firstFormat = heapFormatList;
-
-    heapFormatList = embFormatList_add(heapFormatList, ".100", "Toyota Embroidery Format",           'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".art", "Bernina Embroidery Format",          ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".bmc", "Bitmap Cache Embroidery Format",     ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".bro", "Bits & Volts Embroidery Format",     'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".cnd", "Melco Embroidery Format",            ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".col", "Embroidery Thread Color Format",     'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".csd", "Singer Embroidery Format",           'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".csv", "Comma Separated Values Format",      'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".dat", "Barudan Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".dem", "Melco Embroidery Format",            ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".dsb", "Barudan Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".dst", "Tajima Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".dsz", "ZSK USA Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".dxf", "Drawing Exchange Format",            ' ', ' ', EMBFORMAT_OBJECTONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".edr", "Embird Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".emd", "Elna Embroidery Format",             'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".exp", "Melco Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".exy", "Eltac Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".eys", "Sierra Expanded Embroidery Format",  ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".fxy", "Fortron Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".gc",  "Smoothie G-Code Format",             ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".gnc", "Great Notions Embroidery Format",    ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".gt",  "Gold Thread Embroidery Format",      'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".hus", "Husqvarna Viking Embroidery Format", 'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".inb", "Inbro Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".inf", "Embroidery Color Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".jef", "Janome Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".ksm", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".max", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".mit", "Mitsubishi Embroidery Format",       'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".new", "Ameco Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".ofm", "Melco Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".pcd", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".pcm", "Pfaff Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".pcq", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".pcs", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".pec", "Brother Embroidery Format",          'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".pel", "Brother Embroidery Format",          ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".pem", "Brother Embroidery Format",          ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".pes", "Brother Embroidery Format",          'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".phb", "Brother Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".phc", "Brother Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".plt", "AutoCAD Plot Drawing Format",        'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".rgb", "RGB Embroidery Format",              'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".sew", "Janome Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".shv", "Husqvarna Viking Embroidery Format", 'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".sst", "Sunstar Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".stx", "Data Stitch Embroidery Format",      'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".svg", "Scalable Vector Graphics",           'U', 'U', EMBFORMAT_OBJECTONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".t01", "Pfaff Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".t09", "Pfaff Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".tap", "Happy Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".thr", "ThredWorks Embroidery Format",       'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".txt", "Text File",                          ' ', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".u00", "Barudan Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".u01", "Barudan Embroidery Format",          ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".vip", "Pfaff Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".vp3", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".xxx", "Singer Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".zsk", "ZSK USA Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
+    for(i = 0; i < EMB_FORMAT_COUNT; i++)
+    {
+        heapFormat = (EmbFormatList*)malloc(sizeof(EmbFormatList));
+        if(!heapFormat)
+        {
+            embLog_error("emb-format.c embFormatList_create(), cannot allocate memory for heapFormat\n");
+            embFormatList_free(firstFormat);
+            return 0;
+        }
+        heapFormat->extension = embFormatTable[i].extension;
+        heapFormat->description = embFormatTable[i].description;
+        heapFormat->reader = embFormatTable[i].reader;
+        heapFormat->writer = embFormatTable[i].writer;
+        heapFormat->type = embFormatTable[i].type;
+        heapFormat->next = 0;
+
+        if(lastFormat) lastFormat->next = heapFormat;
+        else           firstFormat = heapFormat;
+        lastFormat = heapFormat;
+    }
 
     return firstFormat;
 }
 
-EmbFormatList* embFormatList_add(EmbFormatList* pointer, char* extension, char* description, char reader, char writer, int type)
-{
-    if(!pointer) { embLog_error("emb-format.c embFormatList_add(), pointer argument is null\n"); return 0; }
-    if(pointer->next) { embLog_error("emb-format.c embFormatList_add(), pointer->next should be null\n"); return 0; }
-    pointer->next = (EmbFormatList*)malloc(sizeof(EmbFormatList));
-    if(!pointer->next) { embLog_error("emb-format.c embFormatList_add(), cannot allocate memory for pointer->next\n"); return 0; }
-    pointer = pointer->next;
-    pointer->extension = extension;
-    pointer->description = description;
-    pointer->reader = reader;
-    pointer->writer = writer;
-    pointer->type = type;
-    pointer->next = 0;
-    return pointer;
-}
-
 int embFormatList_count(EmbFormatList* pointer)
 {
     int i = 1;
@@ -172,212 +259,42 @@ int embFormat_type(EmbFormatList* pointer)
 
 const char* embFormat_extensionFromName(const char* fileName)
 {
-    int i = 0;
-    char ending[2 + EMBFORMAT_MAXEXT];
-    EmbFormatList* formatList = 0;
-    EmbFormatList* curFormat = 0;
-    const char* extension = 0;
-
+    const EmbFormat* format = 0;
     if(!fileName) { embLog_error("emb-format.c embFormat_extensionFromName(), fileName argument is null\n"); return 0; }
-
-    formatList = embFormatList_create();
-
-    if(strlen(fileName) == 0) return 0;
-    if(strrchr(fileName, '.'))
-        strcpy(ending, strrchr(fileName, '.'));
-    else
-        return 0;
-
-    while(ending[i] != '\0')
-    {
-        ending[i] = (char)tolower(ending[i]);
-        ++i;
-    }
-
-    curFormat = formatList;
-    while(curFormat)
-    {
-        if(!strcmp(ending, curFormat->extension))
-        {
-            extension = curFormat->extension;
-            break;
-        }
-
-        curFormat = curFormat->next;
-    }
-
-    embFormatList_free(formatList);
-    formatList = 0;
-
-    return extension;
+    format = embFormat_getByFileName(fileName);
+    return format ? format->extension : 0;
 }
 
 const char* embFormat_descriptionFromName(const char* fileName)
 {
-    int i = 0;
-    char ending[2 + EMBFORMAT_MAXEXT];
-    EmbFormatList* formatList = 0;
-    EmbFormatList* curFormat = 0;
-    const char* description = 0;
-
+    const EmbFormat* format = 0;
     if(!fileName) { embLog_error("emb-format.c embFormat_descriptionFromName(), fileName argument is null\n"); return 0; }
-
-    formatList = embFormatList_create();
-
-    if(strlen(fileName) == 0) return 0;
-    if(strrchr(fileName, '.'))
-        strcpy(ending, strrchr(fileName, '.'));
-    else
-        return 0;
-
-    while(ending[i] != '\0')
-    {
-        ending[i] = (char)tolower(ending[i]);
-        ++i;
-    }
-
-    curFormat = formatList;
-    while(curFormat)
-    {
-        if(!strcmp(ending, curFormat->extension))
-        {
-            description = curFormat->description;
-            break;
-        }
-
-        curFormat = curFormat->next;
-    }
-
-    embFormatList_free(formatList);
-    formatList = 0;
-
-    return description;
+    format = embFormat_getByFileName(fileName);
+    return format ? format->description : 0;
 }
 
 char embFormat_readerStateFromName(const char* fileName)
 {
-    int i = 0;
-    char ending[2 + EMBFORMAT_MAXEXT];
-    EmbFormatList* formatList = 0;
-    EmbFormatList* curFormat = 0;
-    char readerState = ' ';
-
+    const EmbFormat* format = 0;
     if(!fileName) { embLog_error("emb-format.c embFormat_readerStateFromName(), fileName argument is null\n"); return 0; }
-
-    formatList = embFormatList_create();
-
-    if(strlen(fileName) == 0) return 0;
-    if(strrchr(fileName, '.'))
-        strcpy(ending, strrchr(fileName, '.'));
-    else
-        return 0;
-
-    while(ending[i] != '\0')
-    {
-        ending[i] = (char)tolower(ending[i]);
-        ++i;
-    }
-
-    curFormat = formatList;
-    while(curFormat)
-    {
-        if(!strcmp(ending, curFormat->extension))
-        {
-            readerState = curFormat->reader;
-            break;
-        }
-
-        curFormat = curFormat->next;
-    }
-
-    embFormatList_free(formatList);
-    formatList = 0;
-
-    return readerState;
+    format = embFormat_getByFileName(fileName);
+    return format ? format->reader : ' ';
 }
 
 char embFormat_writerStateFromName(const char* fileName)
 {
-    int i = 0;
-    char ending[2 + EMBFORMAT_MAXEXT];
-    EmbFormatList* formatList = 0;
-    EmbFormatList* curFormat = 0;
-    char writerState = ' ';
-
+    const EmbFormat* format = 0;
     if(!fileName) { embLog_error("emb-format.c embFormat_writerStateFromName(), fileName argument is null\n"); return 0; }
-
-    formatList = embFormatList_create();
-
-    if(strlen(fileName) == 0) return 0;
-    if(strrchr(fileName, '.'))
-        strcpy(ending, strrchr(fileName, '.'));
-    else
-        return 0;
-
-    while(ending[i] != '\0')
-    {
-        ending[i] = (char)tolower(ending[i]);
-        ++i;
-    }
-
-    curFormat = formatList;
-    while(curFormat)
-    {
-        if(!strcmp(ending, curFormat->extension))
-        {
-            writerState = curFormat->writer;
-            break;
-        }
-
-        curFormat = curFormat->next;
-    }
-
-    embFormatList_free(formatList);
-    formatList = 0;
-
-    return writerState;
+    format = embFormat_getByFileName(fileName);
+    return format ? format->writer : ' ';
 }
 
 int embFormat_typeFromName(const char* fileName)
 {
-    int i = 0;
-    char ending[2 + EMBFORMAT_MAXEXT];
-    EmbFormatList* formatList = 0;
-    EmbFormatList* curFormat = 0;
-    int type = EMBFORMAT_UNSUPPORTED;
-
+    const EmbFormat* format = 0;
     if(!fileName) { embLog_error("emb-format.c embFormat_typeFromName(), fileName argument is null\n"); return 0; }
-
-    formatList = embFormatList_create();
-
-    if(strlen(fileName) == 0) return 0;
-    if(strrchr(fileName, '.'))
-        strcpy(ending, strrchr(fileName, '.'));
-    else
-        return 0;
-
-    while(ending[i] != '\0')
-    {
-        ending[i] = (char)tolower(ending[i]);
-        ++i;
-    }
-
-    curFormat = formatList;
-    while(curFormat)
-    {
-        if(!strcmp(ending, curFormat->extension))
-        {
-            type = curFormat->type;
-            break;
-        }
-
-        curFormat = curFormat->next;
-    }
-
-    embFormatList_free(formatList);
-    formatList = 0;
-
-    return type;
+    format = embFormat_getByFileName(fileName);
+    return format ? format->type : EMBFORMAT_UNSUPPORTED;
 }
 
 /* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
@@ -1,6 +1,8 @@
 #ifndef EMB_FORMAT_H
 #define EMB_FORMAT_H
 
+#include "emb-reader-writer.h"
+
 #include "api-start.h"
 #ifdef __cplusplus
 extern "C" {
@@ -12,11 +14,25 @@ extern "C" {
 #define EMBFORMAT_STCHANDOBJ  3 /* binary operation: 1+2=3 */
 
 #define EMBFORMAT_MAXEXT 3  /* maximum length of extension without dot */
+#define EMBFORMAT_MAXMAGIC 8 /* bytes needed from the start of a file to identify it */
+
+/* One entry of the built-in format registry, sorted by extension */
+typedef struct EmbFormat_
+{
+    const char* extension;   /* lowercase, including the dot */
+    const char* description;
+    char reader;             /* 'U' if a reader exists, ' ' if not */
+    char writer;             /* 'U' if a writer exists, ' ' if not */
+    int type;
+    EmbReaderWriter readerWriter;
+    const char* magic;       /* leading bytes of the file contents, 0 if the format has none */
+    int magicLength;
+} EmbFormat;
 
 typedef struct EmbFormatList_
 {
-    char* extension;
-    char* description;
+    const char* extension;
+    const char* description;
     char reader;
     char writer;
     int type;
@@ -24,7 +40,6 @@ typedef struct EmbFormatList_
 } EmbFormatList;
 
 extern EMB_PUBLIC EmbFormatList* EMB_CALL embFormatList_create();
-extern EMB_PRIVATE EmbFormatList* EMB_CALL embFormatList_add(EmbFormatList* pointer, char* extension, char* description, char reader, char writer, int type);
 extern EMB_PUBLIC int EMB_CALL embFormatList_count(EmbFormatList* pointer);
 extern EMB_PUBLIC int EMB_CALL embFormatList_empty(EmbFormatList* pointer);
 extern EMB_PUBLIC void EMB_CALL embFormatList_free(EmbFormatList* pointer);
@@ -35,6 +50,11 @@ extern EMB_PUBLIC char EMB_CALL embFormat_readerState(EmbFormatList* pointer);
 extern EMB_PUBLIC char EMB_CALL embFormat_writerState(EmbFormatList* pointer);
 extern EMB_PUBLIC int EMB_CALL embFormat_type(EmbFormatList* pointer);
 
+extern EMB_PUBLIC int EMB_CALL embFormat_count(void);
+extern EMB_PUBLIC const EmbFormat* EMB_CALL embFormat_getByIndex(int index);
+extern EMB_PUBLIC const EmbFormat* EMB_CALL embFormat_getByFileName(const char* fileName);
+extern EMB_PUBLIC const EmbFormat* EMB_CALL embFormat_getByContents(const unsigned char* data, int length);
+
 extern EMB_PUBLIC const char* EMB_CALL embFormat_extensionFromName(const char* fileName);
 extern EMB_PUBLIC const char* EMB_CALL embFormat_descriptionFromName(const char* fileName);
 extern EMB_PUBLIC char EMB_CALL embFormat_readerStateFromName(const char* fileName);
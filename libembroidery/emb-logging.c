@@ -1,47 +1,80 @@
 #include "emb-logging.h"
+#include "emb-context.h"
 
 #include <stdio.h>
 #include <stdarg.h>
 
-/* printf() abstraction. Uses Serial.print() on ARDUINO */
-void embLog_print(const char* format, ...)
-{
-    /* TODO: log debug message in struct for later use */
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define vsnprintf _vsnprintf
+#endif
 
+#define EMB_LOG_MAX_MESSAGE 1024
+
+/* Formats a message that passed the level check of \a context and hands it to the log callback.
+ * Uses Serial.print() on ARDUINO. */
+static void embLog_write(EmbContext* context, int level, const char* format, va_list args)
+{
 #ifdef ARDUINO /* ARDUINO */
     char buff[256];
-    va_list args;
-    va_start(args, format);
+    (void)context;
     vsprintf(buff, format, args);
-    va_end(args);
+    if(level == EMB_LOG_ERROR) inoLog_serial("ERROR: ");
     inoLog_serial(buff);
 #else /* ARDUINO */
+    char buff[EMB_LOG_MAX_MESSAGE];
+    vsnprintf(buff, sizeof(buff), format, args);
+    buff[sizeof(buff) - 1] = '\0';
+    if(level == EMB_LOG_ERROR) embContext_addError(context, buff);
+    if(level >= context->logLevel) context->log(context->logUserData, level, buff);
+#endif /* ARDUINO */
+}
+
+/* Detailed tracing, off unless the current context's logLevel is EMB_LOG_DEBUG */
+void embLog_debug(const char* format, ...)
+{
+    EmbContext* context = embContext_current();
     va_list args;
+
+    if(context->logLevel > EMB_LOG_DEBUG) return;
     va_start(args, format);
-    vprintf(format, args);
+    embLog_write(context, EMB_LOG_DEBUG, format, args);
     va_end(args);
-#endif /* ARDUINO */
 }
 
-/* serious errors */
-void embLog_error(const char* format, ...)
+/* printf() abstraction for informational messages */
+void embLog_print(const char* format, ...)
 {
-    /* TODO: log debug message in struct for later use */
+    EmbContext* context = embContext_current();
+    va_list args;
 
-#ifdef ARDUINO /* ARDUINO */
-    char buff[256];
+    if(context->logLevel > EMB_LOG_INFO) return;
+    va_start(args, format);
+    embLog_write(context, EMB_LOG_INFO, format, args);
+    va_end(args);
+}
+
+/* recoverable problems in the input or the pattern */
+void embLog_warning(const char* format, ...)
+{
+    EmbContext* context = embContext_current();
     va_list args;
+
+    if(context->logLevel > EMB_LOG_WARNING) return;
     va_start(args, format);
-    vsprintf(buff, format, args);
+    embLog_write(context, EMB_LOG_WARNING, format, args);
     va_end(args);
-    inoLog_serial(strcat("ERROR: ", buff));
-#else /* ARDUINO */
+}
+
+/* serious errors, also collected by the current context even when they are not logged */
+void embLog_error(const char* format, ...)
+{
+    EmbContext* context = embContext_current();
     va_list args;
+
+    if(context->logLevel > EMB_LOG_ERROR && !context->collectErrors) return;
     va_start(args, format);
-    printf("ERROR: ");
-    vprintf(format, args);
+    embLog_write(context, EMB_LOG_ERROR, format, args);
     va_end(args);
-#endif /* ARDUINO */
 }
 
 /* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
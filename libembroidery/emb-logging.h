@@ -11,7 +11,16 @@ extern "C" {
 #include "utility/ino-logging.h"
 #endif
 
+/* Log levels, a context only passes messages at or above its logLevel to its log callback */
+#define EMB_LOG_DEBUG   0
+#define EMB_LOG_INFO    1
+#define EMB_LOG_WARNING 2
+#define EMB_LOG_ERROR   3
+#define EMB_LOG_NONE    4
+
+extern EMB_PUBLIC void EMB_CALL embLog_debug(const char* format, ...);
 extern EMB_PUBLIC void EMB_CALL embLog_print(const char* format, ...);
+extern EMB_PUBLIC void EMB_CALL embLog_warning(const char* format, ...);
 extern EMB_PUBLIC void EMB_CALL embLog_error(const char* format, ...);
 
 #ifdef __cplusplus
@@ -23,6 +23,7 @@ EmbPattern* embPattern_create(void)
     p->settings = embSettings_init();
     p->currentColorIndex = 0;
     p->stitchList = 0;
+    p->fixedStitches = 0;
     p->threadList = 0;
 
     p->hoop.height = 0.0;
@@ -58,6 +59,128 @@ EmbPattern* embPattern_create(void)
     return p;
 }
 
+/*! Returns a pointer to an EmbPattern in fixed-point mode. Its stitches are quantized to 0.1 mm once, as they
+ *  are added, and kept in \c fixedStitches at 12 bytes each while \c stitchList stays empty. Readers and writers
+ *  that do not work on fixed-point stitches are given a temporary stitch list by embPattern_read() and embPattern_write().
+ *  The caller is responsible for freeing the allocated memory with embPattern_free(). */
+EmbPattern* embPattern_createFixed(void)
+{
+    EmbPattern* p = embPattern_create();
+    if(!p) return 0;
+
+    p->fixedStitches = embStitchArray_create(1024);
+    if(!p->fixedStitches)
+    {
+        embPattern_free(p);
+        return 0;
+    }
+    return p;
+}
+
+/* Returns \c true if the pattern (\a p) has at least one stitch. */
+static int embPattern_hasStitches(EmbPattern* p)
+{
+    if(p->fixedStitches) return p->fixedStitches->count > 0;
+    return !embStitchList_empty(p->stitchList);
+}
+
+/* Returns the flags of the last stitch of the pattern (\a p), which must have stitches. */
+static int embPattern_lastStitchFlags(EmbPattern* p)
+{
+    if(p->fixedStitches) return p->fixedStitches->stitch[p->fixedStitches->count - 1].flags;
+    return p->lastStitch->stitch.flags;
+}
+
+/*! Returns the number of stitches in the pattern (\a p). */
+int embPattern_stitchCount(EmbPattern* p)
+{
+    if(!p) { embLog_error("emb-pattern.c embPattern_stitchCount(), p argument is null\n"); return 0; }
+    if(p->fixedStitches) return p->fixedStitches->count;
+    return embStitchList_count(p->stitchList);
+}
+
+/*! Returns the stitches of the pattern (\a p) quantized to 0.1 mm. For a fixed-point pattern these are its own
+ *  stitches, otherwise they are quantized from the stitch list into a new array.
+ *  Release the array with embPattern_freeStitchArray(). Returns 0 on failure. */
+EmbStitchArray* embPattern_getStitchArray(EmbPattern* p)
+{
+    if(!p) { embLog_error("emb-pattern.c embPattern_getStitchArray(), p argument is null\n"); return 0; }
+    if(p->fixedStitches) return p->fixedStitches;
+    return embStitchArray_fromList(p->stitchList, 10.0);
+}
+
+/*! Frees an \a array returned by embPattern_getStitchArray() for the pattern (\a p), unless the pattern owns it. */
+void embPattern_freeStitchArray(EmbPattern* p, EmbStitchArray* array)
+{
+    if(!p) { embLog_error("emb-pattern.c embPattern_freeStitchArray(), p argument is null\n"); return; }
+    if(array != p->fixedStitches) embStitchArray_free(array);
+}
+
+/* Moves the stitches of the fixed-point pattern (\a p) to a new stitch list, so that code which only knows
+ * the list can run on it. The pattern is in list mode until embPattern_listToFixed() is called.
+ * Returns \c true if successful, otherwise returns \c false and leaves the pattern unchanged. */
+static int embPattern_fixedToList(EmbPattern* p)
+{
+    EmbStitchList* list = 0;
+    EmbStitchList* last = 0;
+    EmbStitch s;
+    int i;
+
+    for(i = 0; i < p->fixedStitches->count; i++)
+    {
+        const EmbStitchFixed* f = &p->fixedStitches->stitch[i];
+        s.xx = f->x / 10.0;
+        s.yy = f->y / 10.0;
+        s.flags = f->flags;
+        s.color = f->color;
+        if(!list) last = list = embStitchList_create(s);
+        else      last = embStitchList_add(last, s);
+        if(!last)
+        {
+            embStitchList_free(list);
+            return 0;
+        }
+    }
+    embStitchArray_free(p->fixedStitches);
+    p->fixedStitches = 0;
+    p->stitchList = list;
+    p->lastStitch = last;
+    return 1;
+}
+
+/* Quantizes the stitch list of the pattern (\a p) back into fixed-point stitches after embPattern_fixedToList().
+ * Returns \c true if successful, otherwise returns \c false and leaves the pattern in list mode. */
+static int embPattern_listToFixed(EmbPattern* p)
+{
+    EmbStitchArray* array = embStitchArray_fromList(p->stitchList, 10.0);
+    if(!array) return 0;
+
+    embStitchList_free(p->stitchList);
+    p->stitchList = 0;
+    p->lastStitch = 0;
+    p->fixedStitches = array;
+    return 1;
+}
+
+/* Runs \a function on the pattern (\a p), which must be in fixed-point mode, with its stitches in a temporary stitch list. */
+static int embPattern_callWithList(EmbPattern* p, const char* fileName, int (*function)(EmbPattern*, const char*))
+{
+    int result;
+
+    if(!embPattern_fixedToList(p))
+    {
+        embLog_error("emb-pattern.c embPattern_callWithList(), cannot convert the fixed-point stitches to a stitch list\n");
+        return 0;
+    }
+    result = function(p, fileName);
+    if(!embPattern_listToFixed(p))
+    {
+        embLog_error("emb-pattern.c embPattern_callWithList(), cannot convert the stitch list back to fixed-point stitches\n");
+        return 0;
+    }
+    return result;
+}
+
 void embPattern_hideStitchesOverLength(EmbPattern* p, int length)
 {
     double prevX = 0;
@@ -65,6 +188,21 @@ void embPattern_hideStitchesOverLength(EmbPattern* p, int length)
     EmbStitchList* pointer = 0;
 
     if(!p) { embLog_error("emb-pattern.c embPattern_hideStitchesOverLength(), p argument is null\n"); return; }
+    if(p->fixedStitches)
+    {
+        int i, prevFixedX = 0, prevFixedY = 0;
+        for(i = 0; i < p->fixedStitches->count; i++)
+        {
+            EmbStitchFixed* f = &p->fixedStitches->stitch[i];
+            if((abs(f->x - prevFixedX) > length * 10) || (abs(f->y - prevFixedY) > length * 10))
+            {
+                f->flags |= TRIM;
+            }
+            prevFixedX = f->x;
+            prevFixedY = f->y;
+        }
+        return;
+    }
     pointer = p->stitchList;
     while(pointer)
     {
@@ -100,6 +238,14 @@ void embPattern_fixColorCount(EmbPattern* p)
     EmbStitchList* list = 0;
 
     if(!p) { embLog_error("emb-pattern.c embPattern_fixColorCount(), p argument is null\n"); return; }
+    if(p->fixedStitches)
+    {
+        int i;
+        for(i = 0; i < p->fixedStitches->count; i++)
+        {
+            maxColorIndex = max(maxColorIndex, p->fixedStitches->stitch[i].color);
+        }
+    }
     list = p->stitchList;
     while(list)
     {
@@ -131,6 +277,14 @@ void embPattern_copyStitchListToPolylines(EmbPattern* p)
 
     if(!p) { embLog_error("emb-pattern.c embPattern_copyStitchListToPolylines(), p argument is null\n"); return; }
 
+    if(p->fixedStitches)
+    {
+        if(!embPattern_fixedToList(p)) { embLog_error("emb-pattern.c embPattern_copyStitchListToPolylines(), cannot convert the fixed-point stitches to a stitch list\n"); return; }
+        embPattern_copyStitchListToPolylines(p);
+        if(!embPattern_listToFixed(p)) { embLog_error("emb-pattern.c embPattern_copyStitchListToPolylines(), cannot convert the stitch list back to fixed-point stitches\n"); }
+        return;
+    }
+
 #ifdef EMB_DEBUG_JUMP
     breakAtFlags = (STOP | TRIM);
 #else /* EMB_DEBUG_JUMP */
@@ -241,6 +395,7 @@ void embPattern_moveStitchListToPolylines(EmbPattern* p)
     embStitchList_free(p->stitchList);
     p->stitchList = 0;
     p->lastStitch = 0;
+    if(p->fixedStitches) p->fixedStitches->count = 0;
     embThreadList_free(p->threadList);
     p->threadList = 0;
     p->lastThread = 0;
@@ -256,6 +411,17 @@ void embPattern_movePolylinesToStitchList(EmbPattern* p)
     p->lastPolylineObj = 0;
 }
 
+/* Quantizes \a s to 0.1 mm and appends it to the stitches of the fixed-point pattern (\a p). */
+static void embPattern_addFixedStitch(EmbPattern* p, EmbStitch s)
+{
+    EmbStitchFixed f;
+    f.x = roundDouble(s.xx * 10.0);
+    f.y = roundDouble(s.yy * 10.0);
+    f.flags = (unsigned short)s.flags;
+    f.color = (unsigned short)s.color;
+    embStitchArray_add(p->fixedStitches, f);
+}
+
 /*! Adds a stitch to the pattern (\a p) at the absolute position (\a x,\a y). Positive y is up. Units are in millimeters. */
 void embPattern_addStitchAbs(EmbPattern* p, double x, double y, int flags, int isAutoColorIndex)
 {
@@ -265,12 +431,12 @@ void embPattern_addStitchAbs(EmbPattern* p, double x, double y, int flags, int i
 
     if(flags & END)
     {
-        if(embStitchList_empty(p->stitchList))
+        if(!embPattern_hasStitches(p))
             return;
         /* Prevent unnecessary multiple END stitches */
-        if(p->lastStitch->stitch.flags & END)
+        if(embPattern_lastStitchFlags(p) & END)
         {
-            embLog_error("emb-pattern.c embPattern_addStitchAbs(), found multiple END stitches\n");
+            embLog_warning("emb-pattern.c embPattern_addStitchAbs(), found multiple END stitches\n");
             return;
         }
 
@@ -281,14 +447,14 @@ void embPattern_addStitchAbs(EmbPattern* p, double x, double y, int flags, int i
 
     if(flags & STOP)
     {
-        if(embStitchList_empty(p->stitchList))
+        if(!embPattern_hasStitches(p))
             return;
         if(isAutoColorIndex)
             p->currentColorIndex++;
     }
 
     /* NOTE: If the stitchList is empty, we will create it before adding stitches to it. The first coordinate will be the HOME position. */
-    if(embStitchList_empty(p->stitchList))
+    if(!embPattern_hasStitches(p))
     {
         /* NOTE: Always HOME the machine before starting any stitching */
         EmbPoint home = embSettings_home(&(p->settings));
@@ -297,18 +463,26 @@ void embPattern_addStitchAbs(EmbPattern* p, double x, double y, int flags, int i
         h.yy = home.yy;
         h.flags = JUMP;
         h.color = p->currentColorIndex;
-        p->stitchList = p->lastStitch = embStitchList_create(h);
+        if(p->fixedStitches) embPattern_addFixedStitch(p, h);
+        else                 p->stitchList = p->lastStitch = embStitchList_create(h);
     }
 
     s.xx = x;
     s.yy = y;
     s.flags = flags;
     s.color = p->currentColorIndex;
+    if(p->fixedStitches)
+    {
+        embPattern_addFixedStitch(p, s);
+    }
+    else
+    {
 #ifdef ARDUINO
-    inoEvent_addStitchAbs(p, s.xx, s.yy, s.flags, s.color);
+        inoEvent_addStitchAbs(p, s.xx, s.yy, s.flags, s.color);
 #else /* ARDUINO */
-    p->lastStitch = embStitchList_add(p->lastStitch, s);
+        p->lastStitch = embStitchList_add(p->lastStitch, s);
 #endif /* ARDUINO */
+    }
     p->lastX = s.xx;
     p->lastY = s.yy;
 }
@@ -319,7 +493,7 @@ void embPattern_addStitchRel(EmbPattern* p, double dx, double dy, int flags, int
     double x,y;
 
     if(!p) { embLog_error("emb-pattern.c embPattern_addStitchRel(), p argument is null\n"); return; }
-    if(!embStitchList_empty(p->stitchList))
+    if(embPattern_hasStitches(p))
     {
         x = p->lastX + dx;
         y = p->lastY + dy;
@@ -334,6 +508,16 @@ void embPattern_addStitchRel(EmbPattern* p, double dx, double dy, int flags, int
     embPattern_addStitchAbs(p, x, y, flags, isAutoColorIndex);
 }
 
+/*! Adds an END stitch at the last position of the pattern (\a p) unless it has no stitches or already ends with one. */
+void embPattern_end(EmbPattern* p)
+{
+    if(!p) { embLog_error("emb-pattern.c embPattern_end(), p argument is null\n"); return; }
+    if(embPattern_hasStitches(p) && !(embPattern_lastStitchFlags(p) & END))
+    {
+        embPattern_addStitchRel(p, 0.0, 0.0, END, 1);
+    }
+}
+
 void embPattern_changeColor(EmbPattern* p, int index)
 {
     if(!p) { embLog_error("emb-pattern.c embPattern_changeColor(), p argument is null\n"); return; }
@@ -344,35 +528,54 @@ void embPattern_changeColor(EmbPattern* p, int index)
  *  Returns \c true if successful, otherwise returns \c false. */
 int embPattern_read(EmbPattern* pattern, const char* fileName) /* TODO: Write test case using this convenience function. */
 {
-    EmbReaderWriter* reader = 0;
-    int result = 0;
+    const EmbReaderWriter* reader = 0;
 
     if(!pattern) { embLog_error("emb-pattern.c embPattern_read(), pattern argument is null\n"); return 0; }
     if(!fileName) { embLog_error("emb-pattern.c embPattern_read(), fileName argument is null\n"); return 0; }
 
     reader = embReaderWriter_getByFileName(fileName);
+    if(!reader) reader = embReaderWriter_getByContents(fileName);
     if(!reader) { embLog_error("emb-pattern.c embPattern_read(), unsupported read file type: %s\n", fileName); return 0; }
-    result = reader->reader(pattern, fileName);
-    free(reader);
-    reader = 0;
-    return result;
+    if(pattern->fixedStitches && !(reader->fixedPoint & EMB_RW_FIXED_READ))
+        return embPattern_callWithList(pattern, fileName, reader->reader);
+    return reader->reader(pattern, fileName);
 }
 
 /*! Writes the data from \a pattern to a file with the given \a fileName.
  *  Returns \c true if successful, otherwise returns \c false. */
 int embPattern_write(EmbPattern* pattern, const char* fileName) /* TODO: Write test case using this convenience function. */
 {
-    EmbReaderWriter* writer = 0;
-    int result = 0;
+    const EmbReaderWriter* writer = 0;
 
     if(!pattern) { embLog_error("emb-pattern.c embPattern_write(), pattern argument is null\n"); return 0; }
     if(!fileName) { embLog_error("emb-pattern.c embPattern_write(), fileName argument is null\n"); return 0; }
 
     writer = embReaderWriter_getByFileName(fileName);
     if(!writer) { embLog_error("emb-pattern.c embPattern_write(), unsupported write file type: %s\n", fileName); return 0; }
-    result = writer->writer(pattern, fileName);
-    free(writer);
-    writer = 0;
+    if(pattern->fixedStitches && !(writer->fixedPoint & EMB_RW_FIXED_WRITE))
+        return embPattern_callWithList(pattern, fileName, writer->writer);
+    return writer->writer(pattern, fileName);
+}
+
+/*! Reads a file with the given \a fileName into \a pattern like embPattern_read(),
+ *  allocating and logging through \a context while it runs.
+ *  Returns \c true if successful, otherwise returns \c false. */
+int embPattern_readWithContext(EmbContext* context, EmbPattern* pattern, const char* fileName)
+{
+    EmbContext* previous = embContext_bind(context);
+    int result = embPattern_read(pattern, fileName);
+    embContext_bind(previous);
+    return result;
+}
+
+/*! Writes \a pattern to a file with the given \a fileName like embPattern_write(),
+ *  allocating and logging through \a context while it runs.
+ *  Returns \c true if successful, otherwise returns \c false. */
+int embPattern_writeWithContext(EmbContext* context, EmbPattern* pattern, const char* fileName)
+{
+    EmbContext* previous = embContext_bind(context);
+    int result = embPattern_write(pattern, fileName);
+    embContext_bind(previous);
     return result;
 }
 
@@ -383,6 +586,15 @@ void embPattern_scale(EmbPattern* p, double scale)
     EmbStitchList* pointer = 0;
 
     if(!p) { embLog_error("emb-pattern.c embPattern_scale(), p argument is null\n"); return; }
+    if(p->fixedStitches)
+    {
+        int i;
+        for(i = 0; i < p->fixedStitches->count; i++)
+        {
+            p->fixedStitches->stitch[i].x = roundDouble(p->fixedStitches->stitch[i].x * scale);
+            p->fixedStitches->stitch[i].y = roundDouble(p->fixedStitches->stitch[i].y * scale);
+        }
+    }
     pointer = p->stitchList;
     while(pointer)
     {
@@ -429,7 +641,7 @@ EmbRect embPattern_calcBoundingBox(EmbPattern* p)
     /* Calculate the bounding rectangle.  It's needed for smart repainting. */
     /* TODO: Come back and optimize this mess so that after going thru all objects
             and stitches, if the rectangle isn't reasonable, then return a default rect */
-    if(embStitchList_empty(p->stitchList) &&
+    if(!embPattern_hasStitches(p) &&
     embArcObjectList_empty(p->arcObjList) &&
     embCircleObjectList_empty(p->circleObjList) &&
     embEllipseObjectList_empty(p->ellipseObjList) &&
@@ -466,6 +678,21 @@ EmbRect embPattern_calcBoundingBox(EmbPattern* p)
         }
         pointer = pointer->next;
     }
+    if(p->fixedStitches)
+    {
+        int i;
+        for(i = 0; i < p->fixedStitches->count; i++)
+        {
+            const EmbStitchFixed* f = &p->fixedStitches->stitch[i];
+            if(!(f->flags & TRIM))
+            {
+                boundingRect.left = (double)min(boundingRect.left, f->x / 10.0);
+                boundingRect.top = (double)min(boundingRect.top, f->y / 10.0);
+                boundingRect.right = (double)max(boundingRect.right, f->x / 10.0);
+                boundingRect.bottom = (double)max(boundingRect.bottom, f->y / 10.0);
+            }
+        }
+    }
 
     aObjList = p->arcObjList;
     while(aObjList)
@@ -606,6 +833,15 @@ void embPattern_flip(EmbPattern* p, int horz, int vert)
         if(vert) { stList->stitch.yy = -stList->stitch.yy; }
         stList = stList->next;
     }
+    if(p->fixedStitches)
+    {
+        int i;
+        for(i = 0; i < p->fixedStitches->count; i++)
+        {
+            if(horz) { p->fixedStitches->stitch[i].x = -p->fixedStitches->stitch[i].x; }
+            if(vert) { p->fixedStitches->stitch[i].y = -p->fixedStitches->stitch[i].y; }
+        }
+    }
 
     aObjList = p->arcObjList;
     while(aObjList)
@@ -724,6 +960,32 @@ void embPattern_combineJumpStitches(EmbPattern* p)
     EmbStitchList* jumpListStart = 0;
 
     if(!p) { embLog_error("emb-pattern.c embPattern_combineJumpStitches(), p argument is null\n"); return; }
+    if(p->fixedStitches)
+    {
+        EmbStitchFixed* stitch = p->fixedStitches->stitch;
+        int i, next, count = 0;
+        for(i = 0; i < p->fixedStitches->count; i++)
+        {
+            if(stitch[i].flags & JUMP)
+            {
+                next = i + 1;
+                while(next < p->fixedStitches->count && (stitch[next].flags & JUMP)) next++;
+                if(next < p->fixedStitches->count)
+                {
+                    /* the first jump of the run goes straight to the next stitch, the others are dropped */
+                    stitch[count] = stitch[i];
+                    stitch[count].x = stitch[next].x;
+                    stitch[count].y = stitch[next].y;
+                    count++;
+                    i = next - 1;
+                    continue;
+                }
+            }
+            stitch[count++] = stitch[i];
+        }
+        p->fixedStitches->count = count;
+        return;
+    }
     pointer = p->stitchList;
     while(pointer)
     {
@@ -757,6 +1019,53 @@ void embPattern_combineJumpStitches(EmbPattern* p)
     }
 }
 
+/* embPattern_correctForMaxStitchLength() for the fixed-point pattern (\a p), with the lengths in 0.1 mm.
+ * The stitches are copied to a new array with the extra stitches inserted. */
+static void embPattern_correctFixedForMaxStitchLength(EmbPattern* p, double maxStitchLength, double maxJumpLength)
+{
+    EmbStitchArray* source = p->fixedStitches;
+    EmbStitchArray* corrected = 0;
+    int i, j, splits;
+    double maxXY, maxLen;
+
+    if(source->count > 1)
+    {
+        corrected = embStitchArray_create(source->count);
+        if(!corrected) return;
+        corrected->stitch[corrected->count++] = source->stitch[0];
+        for(i = 1; i < source->count; i++)
+        {
+            const EmbStitchFixed* prev = &source->stitch[i - 1];
+            const EmbStitchFixed* current = &source->stitch[i];
+            double dx = current->x - prev->x;
+            double dy = current->y - prev->y;
+            if((fabs(dx) > maxStitchLength) || (fabs(dy) > maxStitchLength))
+            {
+                maxXY = max(fabs(dx), fabs(dy));
+                if(current->flags & (JUMP | TRIM)) maxLen = maxJumpLength;
+                else maxLen = maxStitchLength;
+
+                splits = (int)ceil(maxXY / maxLen);
+                for(j = 1; j < splits; j++)
+                {
+                    EmbStitchFixed s = *current;
+                    s.x = roundDouble(prev->x + dx / splits * j);
+                    s.y = roundDouble(prev->y + dy / splits * j);
+                    if(!embStitchArray_add(corrected, s)) { embStitchArray_free(corrected); return; }
+                }
+            }
+            if(!embStitchArray_add(corrected, *current)) { embStitchArray_free(corrected); return; }
+        }
+        embStitchArray_free(source);
+        p->fixedStitches = corrected;
+    }
+    if(embPattern_hasStitches(p) && embPattern_lastStitchFlags(p) != END)
+    {
+        const EmbStitchFixed* last = &p->fixedStitches->stitch[p->fixedStitches->count - 1];
+        embPattern_addStitchAbs(p, last->x / 10.0, last->y / 10.0, END, 1);
+    }
+}
+
 /*TODO: The params determine the max XY movement rather than the length. They need renamed or clarified further. */
 void embPattern_correctForMaxStitchLength(EmbPattern* p, double maxStitchLength, double maxJumpLength)
 {
@@ -764,6 +1073,11 @@ void embPattern_correctForMaxStitchLength(EmbPattern* p, double maxStitchLength,
     double maxXY, maxLen, addX, addY;
 
     if(!p) { embLog_error("emb-pattern.c embPattern_correctForMaxStitchLength(), p argument is null\n"); return; }
+    if(p->fixedStitches)
+    {
+        embPattern_correctFixedForMaxStitchLength(p, maxStitchLength * 10.0, maxJumpLength * 10.0);
+        return;
+    }
     if(embStitchList_count(p->stitchList) > 1)
     {
         EmbStitchList* pointer = 0;
@@ -853,7 +1167,7 @@ void embPattern_loadExternalColorFile(EmbPattern* p, const char* fileName)
 #endif /* ARDUINO */
 
     char hasRead = 0;
-    EmbReaderWriter* colorFile = 0;
+    const EmbReaderWriter* colorFile = 0;
     const char* dotPos = strrchr(fileName, '.');
     char* extractName = 0;
 
@@ -872,8 +1186,6 @@ void embPattern_loadExternalColorFile(EmbPattern* p, const char* fileName)
     }
     if(!hasRead)
     {
-        free(colorFile);
-        colorFile = 0;
         extractName = (char*)memcpy(extractName, fileName, dotPos - fileName);
         extractName[dotPos - fileName] = '\0';
         strcat(extractName,".rgb");
@@ -885,8 +1197,6 @@ void embPattern_loadExternalColorFile(EmbPattern* p, const char* fileName)
     }
     if(!hasRead)
     {
-        free(colorFile);
-        colorFile = 0;
         extractName = (char*)memcpy(extractName, fileName, dotPos - fileName);
         extractName[dotPos - fileName] = '\0';
         strcat(extractName,".col");
@@ -898,8 +1208,6 @@ void embPattern_loadExternalColorFile(EmbPattern* p, const char* fileName)
     }
     if(!hasRead)
     {
-        free(colorFile);
-        colorFile = 0;
         extractName = (char*)memcpy(extractName, fileName, dotPos - fileName);
         extractName[dotPos - fileName] = '\0';
         strcat(extractName,".inf");
@@ -909,8 +1217,6 @@ void embPattern_loadExternalColorFile(EmbPattern* p, const char* fileName)
             hasRead = (char)colorFile->reader(p, extractName);
         }
     }
-    free(colorFile);
-    colorFile = 0;
     free(extractName);
     extractName = 0;
 }
@@ -920,6 +1226,7 @@ void embPattern_free(EmbPattern* p)
 {
     if(!p) { embLog_error("emb-pattern.c embPattern_free(), p argument is null\n"); return; }
     embStitchList_free(p->stitchList);              p->stitchList = 0;      p->lastStitch = 0;
+    embStitchArray_free(p->fixedStitches);          p->fixedStitches = 0;
     embThreadList_free(p->threadList);              p->threadList = 0;      p->lastThread = 0;
 
     embArcObjectList_free(p->arcObjList);           p->arcObjList = 0;      p->lastArcObj = 0;
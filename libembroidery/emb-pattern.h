@@ -4,6 +4,7 @@
 
 #include "emb-arc.h"
 #include "emb-circle.h"
+#include "emb-context.h"
 #include "emb-ellipse.h"
 #include "emb-hoop.h"
 #include "emb-line.h"
@@ -27,6 +28,7 @@ typedef struct EmbPattern_
     EmbSettings settings;
     EmbHoop hoop;
     EmbStitchList* stitchList;
+    EmbStitchArray* fixedStitches; /* used instead of stitchList by patterns from embPattern_createFixed(), 0 otherwise */
     EmbThreadList* threadList;
 
     EmbArcObjectList* arcObjList;
@@ -60,11 +62,16 @@ typedef struct EmbPattern_
 } EmbPattern;
 
 extern EMB_PUBLIC EmbPattern* EMB_CALL embPattern_create(void);
+extern EMB_PUBLIC EmbPattern* EMB_CALL embPattern_createFixed(void);
+extern EMB_PUBLIC int EMB_CALL embPattern_stitchCount(EmbPattern* p);
+extern EMB_PUBLIC EmbStitchArray* EMB_CALL embPattern_getStitchArray(EmbPattern* p);
+extern EMB_PUBLIC void EMB_CALL embPattern_freeStitchArray(EmbPattern* p, EmbStitchArray* array);
 extern EMB_PUBLIC void EMB_CALL embPattern_hideStitchesOverLength(EmbPattern* p, int length);
 extern EMB_PUBLIC void EMB_CALL embPattern_fixColorCount(EmbPattern* p);
 extern EMB_PUBLIC int EMB_CALL embPattern_addThread(EmbPattern* p, EmbThread thread);
 extern EMB_PUBLIC void EMB_CALL embPattern_addStitchAbs(EmbPattern* p, double x, double y, int flags, int isAutoColorIndex);
 extern EMB_PUBLIC void EMB_CALL embPattern_addStitchRel(EmbPattern* p, double dx, double dy, int flags, int isAutoColorIndex);
+extern EMB_PUBLIC void EMB_CALL embPattern_end(EmbPattern* p);
 extern EMB_PUBLIC void EMB_CALL embPattern_changeColor(EmbPattern* p, int index);
 extern EMB_PUBLIC void EMB_CALL embPattern_free(EmbPattern* p);
 extern EMB_PUBLIC void EMB_CALL embPattern_scale(EmbPattern* p, double scale);
@@ -93,6 +100,8 @@ extern EMB_PUBLIC void EMB_CALL embPattern_movePolylinesToStitchList(EmbPattern*
 
 extern EMB_PUBLIC int EMB_CALL embPattern_read(EmbPattern* pattern, const char* fileName);
 extern EMB_PUBLIC int EMB_CALL embPattern_write(EmbPattern* pattern, const char* fileName);
+extern EMB_PUBLIC int EMB_CALL embPattern_readWithContext(EmbContext* context, EmbPattern* pattern, const char* fileName);
+extern EMB_PUBLIC int EMB_CALL embPattern_writeWithContext(EmbContext* context, EmbPattern* pattern, const char* fileName);
 
 #ifdef __cplusplus
 }
@@ -9,13 +9,21 @@
 extern "C" {
 #endif
 
+/* Set in EmbReaderWriter::fixedPoint if the reader or writer works on the
+ * stitches of a pattern from embPattern_createFixed() directly. Others are
+ * given a temporary stitch list by embPattern_read() and embPattern_write(). */
+#define EMB_RW_FIXED_READ  1
+#define EMB_RW_FIXED_WRITE 2
+
 typedef struct EmbReaderWriter_
 {
     int (*reader)(EmbPattern*, const char*);
     int (*writer)(EmbPattern*, const char*);
+    int fixedPoint;
 } EmbReaderWriter;
 
-extern EMB_PUBLIC EmbReaderWriter* EMB_CALL embReaderWriter_getByFileName(const char* fileName);
+extern EMB_PUBLIC const EmbReaderWriter* EMB_CALL embReaderWriter_getByFileName(const char* fileName);
+extern EMB_PUBLIC const EmbReaderWriter* EMB_CALL embReaderWriter_getByContents(const char* fileName);
 
 #ifdef __cplusplus
 }
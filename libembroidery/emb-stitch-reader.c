@@ -0,0 +1,149 @@
+#include "emb-stitch-reader.h"
+#include "emb-format.h"
+#include "emb-logging.h"
+#include "format-dst.h"
+#include "format-pec.h"
+#include "format-pes.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define EMB_STITCH_READER_NONE 0
+#define EMB_STITCH_READER_DST  1
+#define EMB_STITCH_READER_PEC  2
+#define EMB_STITCH_READER_PES  3
+
+static int embStitchReader_formatOf(const char* fileName)
+{
+    const EmbFormat* format = 0;
+
+    if(!fileName) return EMB_STITCH_READER_NONE;
+    format = embFormat_getByFileName(fileName);
+    if(!format) return EMB_STITCH_READER_NONE;
+
+    if(!strcmp(format->extension, ".dst")) return EMB_STITCH_READER_DST;
+    if(!strcmp(format->extension, ".pec")) return EMB_STITCH_READER_PEC;
+    if(!strcmp(format->extension, ".pes")) return EMB_STITCH_READER_PES;
+    return EMB_STITCH_READER_NONE;
+}
+
+/*! Returns \c true if \a fileName is a format that embStitchReader_open() supports. */
+int embStitchReader_canOpen(const char* fileName)
+{
+    return embStitchReader_formatOf(fileName) != EMB_STITCH_READER_NONE;
+}
+
+/*! Opens \a fileName and reads only its header into reader->info.
+ *  Stitches are decoded one at a time by embStitchReader_next().
+ *  Supports DST, PEC and PES. Returns 0 on failure. */
+EmbStitchReader* embStitchReader_open(const char* fileName)
+{
+    EmbStitchReader* reader = 0;
+    int format = embStitchReader_formatOf(fileName);
+    int ok = 0;
+
+    if(!fileName) { embLog_error("emb-stitch-reader.c embStitchReader_open(), fileName argument is null\n"); return 0; }
+    if(format == EMB_STITCH_READER_NONE)
+    {
+        embLog_error("emb-stitch-reader.c embStitchReader_open(), unsupported format %s\n", fileName);
+        return 0;
+    }
+
+    reader = (EmbStitchReader*)malloc(sizeof(EmbStitchReader));
+    if(!reader) { embLog_error("emb-stitch-reader.c embStitchReader_open(), cannot allocate memory for reader\n"); return 0; }
+    memset(reader, 0, sizeof(EmbStitchReader));
+
+    reader->file = embFile_open(fileName, "rb");
+    if(!reader->file)
+    {
+        embLog_error("emb-stitch-reader.c embStitchReader_open(), cannot open %s for reading\n", fileName);
+        free(reader);
+        return 0;
+    }
+
+    switch(format)
+    {
+        case EMB_STITCH_READER_DST:
+            ok = readDstInfo(reader->file, &reader->info);
+            reader->decode = readDstStitch;
+            break;
+        case EMB_STITCH_READER_PEC:
+            ok = readPecInfo(reader->file, 8, &reader->info);
+            reader->decode = readPecStitch;
+            reader->flipY = 1;
+            break;
+        case EMB_STITCH_READER_PES:
+            ok = readPesInfo(reader->file, &reader->info);
+            reader->decode = readPecStitch;
+            reader->flipY = 1;
+            break;
+    }
+    if(!ok)
+    {
+        embStitchReader_close(reader);
+        return 0;
+    }
+    return reader;
+}
+
+/*! Decodes the next stitch of \a reader into \a stitch, in absolute mm
+ *  with positive y up, as embPattern_read() would store it: the first
+ *  stitch is a JUMP to the HOME position (0, 0) and STOP records before
+ *  the first stitch are skipped, so the same stitches are returned.
+ *  Returns \c false once the END stitch has been returned or the file ends. */
+int embStitchReader_next(EmbStitchReader* reader, EmbStitch* stitch)
+{
+    int dx, dy, flags;
+
+    if(!reader) { embLog_error("emb-stitch-reader.c embStitchReader_next(), reader argument is null\n"); return 0; }
+    if(!stitch) { embLog_error("emb-stitch-reader.c embStitchReader_next(), stitch argument is null\n"); return 0; }
+    if(reader->finished) return 0;
+
+    if(!reader->started)
+    {
+        /* embPattern_addStitchAbs() starts every pattern at HOME */
+        reader->started = 1;
+        stitch->xx = 0.0;
+        stitch->yy = 0.0;
+        stitch->flags = JUMP;
+        stitch->color = 0;
+        return 1;
+    }
+
+    do
+    {
+        if(!reader->decode(reader->file, &dx, &dy, &flags))
+        {
+            /* report a missing END stitch the way the pattern readers add one */
+            flags = END;
+            dx = dy = 0;
+        }
+    }
+    while(!reader->stitched && (flags & STOP) && !(flags & END));
+    reader->stitched = 1;
+
+    if(flags & END)
+    {
+        reader->finished = 1;
+    }
+    if(flags & STOP)
+    {
+        reader->color++;
+    }
+
+    reader->x += dx;
+    reader->y += reader->flipY ? -dy : dy;
+    stitch->xx = reader->x / 10.0;
+    stitch->yy = reader->y / 10.0;
+    stitch->flags = flags;
+    stitch->color = reader->color;
+    return 1;
+}
+
+void embStitchReader_close(EmbStitchReader* reader)
+{
+    if(!reader) return;
+    if(reader->file) embFile_close(reader->file);
+    free(reader);
+}
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
@@ -0,0 +1,63 @@
+/*! @file emb-stitch-reader.h */
+#ifndef EMB_STITCH_READER_H
+#define EMB_STITCH_READER_H
+
+#include "emb-file.h"
+#include "emb-rect.h"
+#include "emb-stitch.h"
+#include "emb-thread.h"
+
+#include "api-start.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EMB_PATTERN_INFO_MAX_THREADS 256
+
+/* Design summary taken from a file header without decoding any stitches.
+ * The values are the ones recorded by the writer, so they can differ from
+ * what embPattern_read() computes from the decoded stitches:
+ * - stitchCount counts the records of the file (DST "ST:"). The pattern and
+ *   embStitchReader_next() also have the JUMP to HOME that starts every
+ *   pattern, one more, and leave out STOP records before the first stitch.
+ * - colorCount is the thread count of the writer (DST "CO:" + 1, PES/PEC
+ *   color table). The pattern has one thread per color reached by STOP
+ *   stitches, fewer if the writer had threads without stitches.
+ * - bounds are rounded to whole 0.1 mm by the writer (DST "+X:" ..., PEC
+ *   sizes), and may be 0.1 mm off from embPattern_calcBoundingBox(). */
+typedef struct EmbPatternInfo_
+{
+    int stitchCount; /* stitch records in the file, -1 if the header does not record it */
+    int colorCount;  /* number of threads of the writer */
+    const EmbThread* threads[EMB_PATTERN_INFO_MAX_THREADS]; /* null when the format has no color table */
+    EmbRect bounds;  /* extents in mm relative to the first stitch, positive is up */
+} EmbPatternInfo;
+
+/* Header-first reader that decodes stitches on demand instead of building an EmbPattern */
+typedef struct EmbStitchReader_
+{
+    EmbFile* file;
+    int (*decode)(EmbFile*, int*, int*, int*); /* next relative stitch in 0.1mm */
+    int flipY;    /* format stores y pointing down */
+    int x;        /* current absolute position in 0.1mm */
+    int y;
+    int color;    /* current color index */
+    int started;  /* JUMP to HOME returned */
+    int stitched; /* first stitch record returned */
+    int finished; /* END stitch or end of file reached */
+    EmbPatternInfo info;
+} EmbStitchReader;
+
+extern EMB_PUBLIC int EMB_CALL embStitchReader_canOpen(const char* fileName);
+extern EMB_PUBLIC EmbStitchReader* EMB_CALL embStitchReader_open(const char* fileName);
+extern EMB_PUBLIC int EMB_CALL embStitchReader_next(EmbStitchReader* reader, EmbStitch* stitch);
+extern EMB_PUBLIC void EMB_CALL embStitchReader_close(EmbStitchReader* reader);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#include "api-stop.h"
+
+#endif /* EMB_STITCH_READER_H */
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
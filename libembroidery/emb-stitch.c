@@ -1,5 +1,6 @@
 #include "emb-stitch.h"
 #include "emb-logging.h"
+#include "helpers-misc.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -68,4 +69,64 @@ void embStitchList_free(EmbStitchList* pointer)
     pointer = 0;
 }
 
+EmbStitchArray* embStitchArray_create(int capacity)
+{
+    EmbStitchArray* array = (EmbStitchArray*)malloc(sizeof(EmbStitchArray));
+    if(!array) { embLog_error("emb-stitch.c embStitchArray_create(), cannot allocate memory for array\n"); return 0; }
+    if(capacity < 1) capacity = 1;
+    array->stitch = (EmbStitchFixed*)malloc(sizeof(EmbStitchFixed)*capacity);
+    if(!array->stitch) { embLog_error("emb-stitch.c embStitchArray_create(), cannot allocate memory for array->stitch\n"); free(array); return 0; }
+    array->count = 0;
+    array->capacity = capacity;
+    return array;
+}
+
+/*! Quantizes the stitch list starting at \a pointer into a new EmbStitchArray.
+ *  Coordinates are multiplied by \a scale and rounded once here, so that
+ *  encoders only deal with integer deltas. Use a \a scale of 10.0 to go
+ *  from mm to 0.1 mm. Returns 0 on failure. */
+EmbStitchArray* embStitchArray_fromList(EmbStitchList* pointer, double scale)
+{
+    EmbStitchArray* array = embStitchArray_create(embStitchList_count(pointer));
+    EmbStitchFixed* dst = 0;
+    if(!array) return 0;
+
+    dst = array->stitch;
+    while(pointer)
+    {
+        dst->x = roundDouble(pointer->stitch.xx * scale);
+        dst->y = roundDouble(pointer->stitch.yy * scale);
+        dst->flags = (unsigned short)pointer->stitch.flags;
+        dst->color = (unsigned short)pointer->stitch.color;
+        dst++;
+        pointer = pointer->next;
+    }
+    array->count = (int)(dst - array->stitch);
+    return array;
+}
+
+/*! Appends \a data to \a array, growing it if needed.
+ *  Returns \c true if successful, otherwise returns \c false. */
+int embStitchArray_add(EmbStitchArray* array, EmbStitchFixed data)
+{
+    if(!array) { embLog_error("emb-stitch.c embStitchArray_add(), array argument is null\n"); return 0; }
+    if(array->count >= array->capacity)
+    {
+        int newCapacity = array->capacity * 2;
+        EmbStitchFixed* grown = (EmbStitchFixed*)realloc(array->stitch, sizeof(EmbStitchFixed)*newCapacity);
+        if(!grown) { embLog_error("emb-stitch.c embStitchArray_add(), cannot grow array->stitch\n"); return 0; }
+        array->stitch = grown;
+        array->capacity = newCapacity;
+    }
+    array->stitch[array->count++] = data;
+    return 1;
+}
+
+void embStitchArray_free(EmbStitchArray* array)
+{
+    if(!array) return;
+    free(array->stitch);
+    free(array);
+}
+
 /* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
@@ -29,6 +29,26 @@ typedef struct EmbStitchList_
     struct EmbStitchList_* next;
 } EmbStitchList;
 
+/* Stitch quantized to machine units (0.1 mm), as written by DST, PES,
+ * JEF and HUS. It takes 12 bytes and is kept in a contiguous
+ * EmbStitchArray. A pattern from embPattern_createFixed() stores its
+ * stitches this way instead of in an EmbStitchList, other patterns are
+ * quantized into a temporary array by the encoders. */
+typedef struct EmbStitchFixed_
+{
+    int x; /* absolute position in 0.1 mm */
+    int y; /* positive is up */
+    unsigned short flags; /* uses codes defined above */
+    unsigned short color; /* color number for this stitch */
+} EmbStitchFixed;
+
+typedef struct EmbStitchArray_
+{
+    EmbStitchFixed* stitch;
+    int count;
+    int capacity;
+} EmbStitchArray;
+
 extern EMB_PUBLIC EmbStitchList* EMB_CALL embStitchList_create(EmbStitch data);
 extern EMB_PUBLIC EmbStitchList* EMB_CALL embStitchList_add(EmbStitchList* pointer, EmbStitch data);
 extern EMB_PUBLIC int EMB_CALL embStitchList_count(EmbStitchList* pointer);
@@ -36,6 +56,11 @@ extern EMB_PUBLIC int EMB_CALL embStitchList_empty(EmbStitchList* pointer);
 extern EMB_PUBLIC void EMB_CALL embStitchList_free(EmbStitchList* pointer);
 extern EMB_PUBLIC EmbStitch EMB_CALL embStitchList_getAt(EmbStitchList* pointer, int num);
 
+extern EMB_PUBLIC EmbStitchArray* EMB_CALL embStitchArray_create(int capacity);
+extern EMB_PUBLIC EmbStitchArray* EMB_CALL embStitchArray_fromList(EmbStitchList* pointer, double scale);
+extern EMB_PUBLIC int EMB_CALL embStitchArray_add(EmbStitchArray* array, EmbStitchFixed data);
+extern EMB_PUBLIC void EMB_CALL embStitchArray_free(EmbStitchArray* array);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
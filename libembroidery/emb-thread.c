@@ -3,30 +3,26 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+/* Squared RGB distance, it orders colors the same way as the distance itself without a sqrt() */
+static int embThread_colorDistance(EmbColor a, EmbColor b)
+{
+    int deltaRed = a.r - b.r;
+    int deltaGreen = a.g - b.g;
+    int deltaBlue = a.b - b.b;
+    return deltaRed * deltaRed + deltaGreen * deltaGreen + deltaBlue * deltaBlue;
+}
+
+/* Returns the index of the thread in \a colors closest to \a color, the last one wins a tie. Returns -1 if the list is empty. */
 int embThread_findNearestColor(EmbColor color, EmbThreadList* colors)
 {
-    double currentClosestValue = 9999999;
+    int currentClosestValue = 0x7FFFFFFF;
     int closestIndex = -1;
-    int red = color.r;
-    int green = color.g;
-    int blue = color.b;
     int i = 0;
     EmbThreadList* currentThreadItem = colors;
 
     while(currentThreadItem != NULL)
     {
-        int deltaRed;
-        int deltaBlue;
-        int deltaGreen;
-        double dist;
-        EmbColor c;
-        c = currentThreadItem->thread.color;
-
-        deltaRed = red - c.r;
-        deltaBlue = green - c.g;
-        deltaGreen = blue - c.b;
-
-        dist = sqrt((double)(deltaRed * deltaRed) + (deltaBlue * deltaBlue) + (deltaGreen * deltaGreen));
+        int dist = embThread_colorDistance(color, currentThreadItem->thread.color);
         if(dist <= currentClosestValue)
         {
             currentClosestValue = dist;
@@ -38,28 +34,15 @@ int embThread_findNearestColor(EmbColor color, EmbThreadList* colors)
     return closestIndex;
 }
 
+/* Returns the index of the thread in \a colorArray closest to \a color, the last one wins a tie. Returns -1 if \a count is 0. */
 int embThread_findNearestColorInArray(EmbColor color, EmbThread* colorArray, int count)
 {
-    double currentClosestValue = 9999999;
+    int currentClosestValue = 0x7FFFFFFF;
     int closestIndex = -1;
-    int red = color.r;
-    int green = color.g;
-    int blue = color.b;
     int i = 0;
     for(i = 0; i < count; i++)
     {
-        int deltaRed;
-        int deltaBlue;
-        int deltaGreen;
-        double dist;
-        EmbColor c;
-        c = colorArray[i].color;
-
-        deltaRed = red - c.r;
-        deltaBlue = green - c.g;
-        deltaGreen = blue - c.b;
-
-        dist = sqrt((double)(deltaRed * deltaRed) + (deltaBlue * deltaBlue) + (deltaGreen * deltaGreen));
+        int dist = embThread_colorDistance(color, colorArray[i].color);
         if(dist <= currentClosestValue)
         {
             currentClosestValue = dist;
@@ -69,6 +52,177 @@ int embThread_findNearestColorInArray(EmbColor color, EmbThread* colorArray, int
     return closestIndex;
 }
 
+/* Squared distance from \a value to the nearest and the farthest point of the range [\a low, \a high] */
+static void embThreadPalette_range(double value, double low, double high, double* nearest, double* farthest)
+{
+    double d = value < low ? low - value : (value > high ? value - high : 0.0);
+    double f = value - low > high - value ? value - low : high - value;
+    *nearest += d * d;
+    *farthest += f * f;
+}
+
+/* Squared CIE76 distance between two Lab colors */
+static double embThreadPalette_labDistance(EmbColorLab a, EmbColorLab b)
+{
+    double deltaL = a.l - b.l;
+    double deltaA = a.a - b.a;
+    double deltaB = a.b - b.b;
+    return deltaL * deltaL + deltaA * deltaA + deltaB * deltaB;
+}
+
+/* Lists the threads of \a cell that are not farther from every color in it than some other thread is at most. Returns 0 if out of storage.
+ * In Lab mode the cell is bounded by a Lab box: X, Y and Z grow with every channel, so the darkest and
+ * brightest corner of the cell bound them, and L, a and b follow from those bounds. */
+static int embThreadPalette_buildCell(EmbThreadPalette* palette, int cell)
+{
+    int red = (cell >> 6) << 5;
+    int green = ((cell >> 3) & 7) << 5;
+    int blue = (cell & 7) << 5;
+    double low[3], high[3];
+    double nearest[256];
+    double bound = 1e300;
+    int i;
+
+    if(palette->match == EMB_THREAD_MATCH_LAB)
+    {
+        EmbColorLab dark = embColor_toLab(embColor_make((unsigned char)red, (unsigned char)green, (unsigned char)blue));
+        EmbColorLab bright = embColor_toLab(embColor_make((unsigned char)(red + 31), (unsigned char)(green + 31), (unsigned char)(blue + 31)));
+        double fyLow = (dark.l + 16.0) / 116.0, fyHigh = (bright.l + 16.0) / 116.0;
+        double fxLow = fyLow + dark.a / 500.0, fxHigh = fyHigh + bright.a / 500.0;
+        double fzLow = fyLow - dark.b / 200.0, fzHigh = fyHigh - bright.b / 200.0;
+        low[0] = dark.l;                      high[0] = bright.l;
+        low[1] = 500.0 * (fxLow - fyHigh);    high[1] = 500.0 * (fxHigh - fyLow);
+        low[2] = 200.0 * (fyLow - fzHigh);    high[2] = 200.0 * (fyHigh - fzLow);
+    }
+    else
+    {
+        low[0] = red;   high[0] = red + 31;
+        low[1] = green; high[1] = green + 31;
+        low[2] = blue;  high[2] = blue + 31;
+    }
+
+    for(i = 0; i < palette->count; i++)
+    {
+        double farthest = 0.0;
+        nearest[i] = 0.0;
+        if(palette->match == EMB_THREAD_MATCH_LAB)
+        {
+            embThreadPalette_range(palette->lab[i].l, low[0], high[0], &nearest[i], &farthest);
+            embThreadPalette_range(palette->lab[i].a, low[1], high[1], &nearest[i], &farthest);
+            embThreadPalette_range(palette->lab[i].b, low[2], high[2], &nearest[i], &farthest);
+        }
+        else
+        {
+            EmbColor c = palette->threads[i].color;
+            embThreadPalette_range(c.r, low[0], high[0], &nearest[i], &farthest);
+            embThreadPalette_range(c.g, low[1], high[1], &nearest[i], &farthest);
+            embThreadPalette_range(c.b, low[2], high[2], &nearest[i], &farthest);
+        }
+        if(farthest < bound) bound = farthest;
+    }
+    bound += bound * 1e-9 + 1e-9; /* rounding in the Lab bounds must not drop a tied thread */
+
+    palette->cellStart[cell] = (short)palette->candidatesLength;
+    palette->cellCount[cell] = 0;
+    for(i = 0; i < palette->count; i++)
+    {
+        if(nearest[i] > bound) continue;
+        if(palette->candidatesLength == EMB_THREAD_PALETTE_CANDIDATES)
+        {
+            palette->candidatesLength = palette->cellStart[cell];
+            palette->cellStart[cell] = -1;
+            return 0;
+        }
+        palette->candidates[palette->candidatesLength++] = (unsigned char)i;
+        palette->cellCount[cell]++;
+    }
+    return 1;
+}
+
+/*! Prepares \a palette for RGB lookups in the \a count threads of \a threads. The array must outlive the palette. */
+void embThreadPalette_init(EmbThreadPalette* palette, const EmbThread* threads, int count)
+{
+    embThreadPalette_initMatch(palette, threads, count, EMB_THREAD_MATCH_RGB);
+}
+
+/*! Prepares \a palette for lookups in the \a count threads of \a threads that minimize the \a match distance.
+ *  The thread colors are converted to Lab here once, lookups only convert colors they have not seen recently. */
+void embThreadPalette_initMatch(EmbThreadPalette* palette, const EmbThread* threads, int count, int match)
+{
+    int i;
+    palette->threads = threads;
+    palette->count = count;
+    palette->match = match;
+    palette->candidatesLength = 0;
+    for(i = 0; i < EMB_THREAD_PALETTE_CELLS; i++)
+    {
+        palette->cellStart[i] = -1;
+        palette->cellCount[i] = 0;
+    }
+    for(i = 0; i < EMB_THREAD_PALETTE_MEMO; i++)
+    {
+        palette->memoColor[i] = -1;
+    }
+    if(match == EMB_THREAD_MATCH_LAB)
+    {
+        for(i = 0; i < count && i < 256; i++)
+        {
+            palette->lab[i] = embColor_toLab(threads[i].color);
+        }
+    }
+}
+
+/* Index of the closest of the \a count threads listed in \a indices, or of the first \a count threads if \a indices is null. The last one wins a tie. */
+static int embThreadPalette_scan(const EmbThreadPalette* palette, EmbColor color, const unsigned char* indices, int count)
+{
+    double currentClosestValue = 1e300;
+    int closestIndex = -1;
+    EmbColorLab lab;
+    int i;
+
+    if(palette->match != EMB_THREAD_MATCH_LAB)
+    {
+        if(!indices) return embThread_findNearestColorInArray(color, (EmbThread*)palette->threads, count);
+        for(i = 0; i < count; i++)
+        {
+            double dist = embThread_colorDistance(color, palette->threads[indices[i]].color);
+            if(dist <= currentClosestValue) { currentClosestValue = dist; closestIndex = indices[i]; }
+        }
+        return closestIndex;
+    }
+
+    lab = embColor_toLab(color);
+    for(i = 0; i < count; i++)
+    {
+        int index = indices ? indices[i] : i;
+        double dist = embThreadPalette_labDistance(lab, index < 256 ? palette->lab[index] : embColor_toLab(palette->threads[index].color));
+        if(dist <= currentClosestValue) { currentClosestValue = dist; closestIndex = index; }
+    }
+    return closestIndex;
+}
+
+/*! Returns the index of the thread in \a palette closest to \a color.
+ *  For EMB_THREAD_MATCH_RGB it is the one embThread_findNearestColorInArray() returns. */
+int embThreadPalette_findNearest(EmbThreadPalette* palette, EmbColor color)
+{
+    int cell = ((color.r >> 5) << 6) | ((color.g >> 5) << 3) | (color.b >> 5);
+    long key = ((long)color.r << 16) | ((long)color.g << 8) | color.b;
+    int slot = (color.r * 31 + color.g * 17 + color.b * 7) & (EMB_THREAD_PALETTE_MEMO - 1);
+    int closestIndex;
+
+    if(palette->memoColor[slot] == key) return palette->memoIndex[slot];
+
+    /* Charts with more than 256 threads do not fit the candidate lists */
+    if(palette->count > 256 || (palette->cellStart[cell] < 0 && !embThreadPalette_buildCell(palette, cell)))
+        closestIndex = embThreadPalette_scan(palette, color, 0, palette->count);
+    else
+        closestIndex = embThreadPalette_scan(palette, color, palette->candidates + palette->cellStart[cell], palette->cellCount[cell]);
+
+    palette->memoColor[slot] = key;
+    palette->memoIndex[slot] = (short)closestIndex;
+    return closestIndex;
+}
+
 EmbThread embThread_getRandom(void)
 {
     EmbThread c;
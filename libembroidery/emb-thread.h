@@ -24,10 +24,40 @@ typedef struct EmbThreadList_
     struct EmbThreadList_* next;
 } EmbThreadList;
 
+#define EMB_THREAD_PALETTE_CELLS      512  /* 8x8x8 grid over RGB, each cell spans 32 levels per channel */
+#define EMB_THREAD_PALETTE_CANDIDATES 8192 /* shared storage for the candidate lists of all built cells */
+#define EMB_THREAD_PALETTE_MEMO       64   /* recently matched colors remembered by a palette */
+
+#define EMB_THREAD_MATCH_RGB 0 /* Euclidean distance in sRGB */
+#define EMB_THREAD_MATCH_LAB 1 /* CIE76 Delta E, Euclidean distance in CIELAB */
+
+/* Nearest color lookup over a fixed thread chart such as pecThreads.
+ * Each grid cell lists the only threads that can be nearest to some color inside it,
+ * so a lookup compares a handful of threads instead of the whole chart. Cells are
+ * built the first time a color falls into them. With EMB_THREAD_MATCH_RGB results
+ * match embThread_findNearestColorInArray(). */
+typedef struct EmbThreadPalette_
+{
+    const EmbThread* threads;
+    int count;
+    int match; /* EMB_THREAD_MATCH_* */
+    EmbColorLab lab[256]; /* thread colors converted once, EMB_THREAD_MATCH_LAB only */
+    short cellStart[EMB_THREAD_PALETTE_CELLS]; /* -1 until the cell is built */
+    short cellCount[EMB_THREAD_PALETTE_CELLS];
+    unsigned char candidates[EMB_THREAD_PALETTE_CANDIDATES];
+    int candidatesLength;
+    long memoColor[EMB_THREAD_PALETTE_MEMO]; /* 0xRRGGBB of a recent lookup, -1 when unused */
+    short memoIndex[EMB_THREAD_PALETTE_MEMO];
+} EmbThreadPalette;
+
 extern EMB_PUBLIC int EMB_CALL embThread_findNearestColor(EmbColor color, EmbThreadList* colors);
 extern EMB_PUBLIC int EMB_CALL embThread_findNearestColorInArray(EmbColor color, EmbThread* colorArray, int count);
 extern EMB_PUBLIC EmbThread EMB_CALL embThread_getRandom(void);
 
+extern EMB_PUBLIC void EMB_CALL embThreadPalette_init(EmbThreadPalette* palette, const EmbThread* threads, int count);
+extern EMB_PUBLIC void EMB_CALL embThreadPalette_initMatch(EmbThreadPalette* palette, const EmbThread* threads, int count, int match);
+extern EMB_PUBLIC int EMB_CALL embThreadPalette_findNearest(EmbThreadPalette* palette, EmbColor color);
+
 extern EMB_PUBLIC EmbThreadList* EMB_CALL embThreadList_create(EmbThread data);
 extern EMB_PUBLIC EmbThreadList* EMB_CALL embThreadList_add(EmbThreadList* pointer, EmbThread data);
 extern EMB_PUBLIC int EMB_CALL embThreadList_count(EmbThreadList* pointer);
@@ -8,10 +8,14 @@
 #define CsdSubMaskSize  479
 #define CsdXorMaskSize  501
 
-static char _subMask[CsdSubMaskSize];
-static char _xorMask[CsdXorMaskSize];
+/* Decryption masks of one file, kept per call so concurrent reads do not share them */
+typedef struct CsdDecoder_
+{
+    char subMask[CsdSubMaskSize];
+    char xorMask[CsdXorMaskSize];
+} CsdDecoder;
 
-static void BuildDecryptionTable(int seed)
+static void BuildDecryptionTable(CsdDecoder* decoder, int seed)
 {
     int i;
     const int mul1 = 0x41C64E6D;
@@ -21,17 +25,17 @@ static void BuildDecryptionTable(int seed)
     {
         seed *= mul1;
         seed += add1;
-        _subMask[i] = (char) ((seed >> 16) & 0xFF);
+        decoder->subMask[i] = (char) ((seed >> 16) & 0xFF);
     }
     for(i = 0; i < CsdXorMaskSize; i++)
     {
         seed *= mul1;
         seed += add1;
-        _xorMask[i] = (char) ((seed >> 16) & 0xFF);
+        decoder->xorMask[i] = (char) ((seed >> 16) & 0xFF);
     }
 }
 
-static unsigned char DecodeCsdByte(long fileOffset, unsigned char val, int type)
+static unsigned char DecodeCsdByte(const CsdDecoder* decoder, long fileOffset, unsigned char val, int type)
 {
     static const unsigned char _decryptArray[] =
     {
@@ -90,7 +94,7 @@ static unsigned char DecodeCsdByte(long fileOffset, unsigned char val, int type)
     {
         newOffset = (int) fileOffset;
     }
-    return ((unsigned char) ((unsigned char) (val ^ _xorMask[newOffset%CsdXorMaskSize]) - _subMask[newOffset%CsdSubMaskSize]));
+    return ((unsigned char) ((unsigned char) (val ^ decoder->xorMask[newOffset%CsdXorMaskSize]) - decoder->subMask[newOffset%CsdSubMaskSize]));
 }
 
 /*! Reads a file with the given \a fileName and loads the data into \a pattern.
@@ -106,6 +110,7 @@ int readCsd(EmbPattern* pattern, const char* fileName)
     char endOfStream = 0;
     EmbFile* file = 0;
     unsigned char colorOrder[14];
+    CsdDecoder decoder;
 
     if(!pattern) { embLog_error("format-csd.c readCsd(), pattern argument is null\n"); return 0; }
     if(!fileName) { embLog_error("format-csd.c readCsd(), fileName argument is null\n"); return 0; }
@@ -125,36 +130,36 @@ int readCsd(EmbPattern* pattern, const char* fileName)
     }
     if(type == 0)
     {
-        BuildDecryptionTable(0xC);
+        BuildDecryptionTable(&decoder, 0xC);
     }
     else
     {
-        BuildDecryptionTable(identifier[0]);
+        BuildDecryptionTable(&decoder, identifier[0]);
     }
     embFile_seek(file, 8, SEEK_SET);
     for(i = 0; i < 16; i++)
     {
         EmbThread thread;
-        thread.color.r = DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
-        thread.color.g = DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
-        thread.color.b = DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
+        thread.color.r = DecodeCsdByte(&decoder, embFile_tell(file), binaryReadByte(file), type);
+        thread.color.g = DecodeCsdByte(&decoder, embFile_tell(file), binaryReadByte(file), type);
+        thread.color.b = DecodeCsdByte(&decoder, embFile_tell(file), binaryReadByte(file), type);
         thread.catalogNumber = "";
         thread.description = "";
         embPattern_addThread(pattern, thread);
     }
-    unknown1 = DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
-    unknown2 = DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
+    unknown1 = DecodeCsdByte(&decoder, embFile_tell(file), binaryReadByte(file), type);
+    unknown2 = DecodeCsdByte(&decoder, embFile_tell(file), binaryReadByte(file), type);
 
     for(i = 0; i < 14; i++)
     {
-        colorOrder[i] = (unsigned char) DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
+        colorOrder[i] = (unsigned char) DecodeCsdByte(&decoder, embFile_tell(file), binaryReadByte(file), type);
     }
     for(i = 0; !endOfStream; i++)
     {
         char negativeX, negativeY;
-        unsigned char b0 = DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
-        unsigned char b1 = DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
-        unsigned char b2 = DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
+        unsigned char b0 = DecodeCsdByte(&decoder, embFile_tell(file), binaryReadByte(file), type);
+        unsigned char b1 = DecodeCsdByte(&decoder, embFile_tell(file), binaryReadByte(file), type);
+        unsigned char b2 = DecodeCsdByte(&decoder, embFile_tell(file), binaryReadByte(file), type);
 
         if(b0 == 0xF8 || b0 == 0x87 || b0 == 0x91)
         {
@@ -1,6 +1,7 @@
 #include "format-csv.h"
 #include "emb-file.h"
 #include "emb-logging.h"
+#include "helpers-misc.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -29,6 +30,25 @@ static char* csvStitchFlagToStr(int flags)
     }
 }
 
+/* Writes one stitch entry line, coordinates use the precision of %f with trailing zeroes trimmed. */
+static void csvWriteStitch(EmbFile* file, EmbStitch s)
+{
+    char buffer[2 * EMB_MAX_NUMBER_LENGTH + 32];
+    int length = 0;
+
+    strcpy(buffer, "\"*\",\"");
+    strcat(buffer, csvStitchFlagToStr(s.flags));
+    strcat(buffer, "\",\"");
+    length = (int)strlen(buffer);
+    length += emb_formatDouble(buffer + length, s.xx, 6, 1);
+    memcpy(buffer + length, "\",\"", 3);
+    length += 3;
+    length += emb_formatDouble(buffer + length, s.yy, 6, 1);
+    memcpy(buffer + length, "\"\n", 2);
+    length += 2;
+    embFile_write(buffer, 1, length, file);
+}
+
 static int csvStrToStitchFlag(const char* str)
 {
     if(!str)
@@ -194,10 +214,10 @@ int readCsv(EmbPattern* pattern, const char* fileName)
                             numColorChanges++;
                     }
                     else if(cellNum == 3)
-                        xx = atof(buff);
+                        xx = emb_strtod(buff, 0);
                     else if(cellNum == 4)
                     {
-                        yy = atof(buff);
+                        yy = emb_strtod(buff, 0);
                         embPattern_addStitchAbs(pattern, xx, yy, flags, 1);
                         csvMode = CSV_MODE_NULL;
                         cellNum = 0;
@@ -333,8 +353,7 @@ int writeCsv(EmbPattern* pattern, const char* fileName)
     embFile_printf(file, "\"#\",\"[STITCH_TYPE]\",\"[X]\",\"[Y]\"\n");
     while(sList)
     {
-        EmbStitch s = sList->stitch;
-        embFile_printf(file, "\"*\",\"%s\",\"%f\",\"%f\"\n", csvStitchFlagToStr(s.flags), s.xx, s.yy);
+        csvWriteStitch(file, sList->stitch);
         sList = sList->next;
     }
 
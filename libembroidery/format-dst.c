@@ -30,6 +30,53 @@ static int decode_record_flags(unsigned char b2)
     return returnCode;
 }
 
+/* Decodes the x and y deltas (0.1mm) of the 3 byte stitch record \a b */
+static void decode_record(const unsigned char* b, int* x, int* y)
+{
+    *x = 0;
+    *y = 0;
+    if(b[0] & 0x01)
+        *x += 1;
+    if(b[0] & 0x02)
+        *x -= 1;
+    if(b[0] & 0x04)
+        *x += 9;
+    if(b[0] & 0x08)
+        *x -= 9;
+    if(b[0] & 0x80)
+        *y += 1;
+    if(b[0] & 0x40)
+        *y -= 1;
+    if(b[0] & 0x20)
+        *y += 9;
+    if(b[0] & 0x10)
+        *y -= 9;
+    if(b[1] & 0x01)
+        *x += 3;
+    if(b[1] & 0x02)
+        *x -= 3;
+    if(b[1] & 0x04)
+        *x += 27;
+    if(b[1] & 0x08)
+        *x -= 27;
+    if(b[1] & 0x80)
+        *y += 3;
+    if(b[1] & 0x40)
+        *y -= 3;
+    if(b[1] & 0x20)
+        *y += 27;
+    if(b[1] & 0x10)
+        *y -= 27;
+    if(b[2] & 0x04)
+        *x += 81;
+    if(b[2] & 0x08)
+        *x -= 81;
+    if(b[2] & 0x20)
+        *y += 81;
+    if(b[2] & 0x10)
+        *y -= 81;
+}
+
 static unsigned char setbit(int pos)
 {
     return (unsigned char)(1 << pos);
@@ -220,6 +267,72 @@ static void set_dst_variable(EmbPattern* pattern, char* var, char* val)
     }
 }
 
+/* Returns the numeric value of the header field \a var ("ST", "CO", ...)
+ * in \a header, or \a defaultValue if the field is missing. */
+static int dst_header_int(const char* header, const char* var, int defaultValue)
+{
+    int i;
+    for(i = 0; i + 3 < 512; i++)
+    {
+        if(header[i] == var[0] && header[i + 1] == var[1] && header[i + 2] == ':')
+        {
+            return atoi(&header[i + 3]);
+        }
+    }
+    return defaultValue;
+}
+
+/*! Reads only the 512 byte header of the DST file \a file into \a info and
+ *  leaves \a file positioned at the first stitch record.
+ *  Returns \c true if successful, otherwise returns \c false. */
+int readDstInfo(EmbFile* file, EmbPatternInfo* info)
+{
+    char header[512 + 1];
+    int i;
+
+    if(!file) { embLog_error("format-dst.c readDstInfo(), file argument is null\n"); return 0; }
+    if(!info) { embLog_error("format-dst.c readDstInfo(), info argument is null\n"); return 0; }
+
+    if(embFile_read(header, 1, 512, file) != 512)
+    {
+        embLog_error("format-dst.c readDstInfo(), file is too short for a DST header\n");
+        return 0;
+    }
+    header[512] = '\0';
+    /* atoi must not run past a field into the next one */
+    for(i = 0; i < 512; i++)
+    {
+        if(header[i] == 0x0D || header[i] == 0x1A) header[i] = '\0';
+    }
+
+    info->stitchCount = dst_header_int(header, "ST", -1);
+    info->colorCount = dst_header_int(header, "CO", 0) + 1;
+    for(i = 0; i < info->colorCount && i < EMB_PATTERN_INFO_MAX_THREADS; i++)
+    {
+        info->threads[i] = 0;
+    }
+    info->bounds.right = dst_header_int(header, "+X", 0) / 10.0;
+    info->bounds.left = -dst_header_int(header, "-X", 0) / 10.0;
+    info->bounds.bottom = dst_header_int(header, "+Y", 0) / 10.0;
+    info->bounds.top = -dst_header_int(header, "-Y", 0) / 10.0;
+    return 1;
+}
+
+/*! Decodes the next stitch record of \a file into relative \a dx, \a dy
+ *  (0.1mm) and \a flags. Returns \c false at the end of the file. */
+int readDstStitch(EmbFile* file, int* dx, int* dy, int* flags)
+{
+    unsigned char b[3];
+
+    if(embFile_read(b, 1, 3, file) != 3)
+    {
+        return 0;
+    }
+    decode_record(b, dx, dy);
+    *flags = decode_record_flags(b[2]);
+    return 1;
+}
+
 /*! Reads a file with the given \a fileName and loads the data into \a pattern.
  *  Returns \c true if successful, otherwise returns \c false. */
 int readDst(EmbPattern* pattern, const char* fileName)
@@ -227,11 +340,10 @@ int readDst(EmbPattern* pattern, const char* fileName)
     char var[3];   /* temporary storage variable name */
     char val[512]; /* temporary storage variable value */
     int valpos;
-    unsigned char b[3];
     char header[512 + 1];
     EmbFile* file = 0;
     int i = 0;
-    int flags; /* for converting stitches from file encoding */
+    int dx, dy, flags; /* for converting stitches from file encoding */
 
     /*
     * The header seems to contain information about the design.
@@ -330,62 +442,18 @@ int readDst(EmbPattern* pattern, const char* fileName)
         }
     }
 
-    while(embFile_read(b, 1, 3, file) == 3)
+    while(readDstStitch(file, &dx, &dy, &flags))
     {
-        int x = 0;
-        int y = 0;
-        if(b[0] & 0x01)
-            x += 1;
-        if(b[0] & 0x02)
-            x -= 1;
-        if(b[0] & 0x04)
-            x += 9;
-        if(b[0] & 0x08)
-            x -= 9;
-        if(b[0] & 0x80)
-            y += 1;
-        if(b[0] & 0x40)
-            y -= 1;
-        if(b[0] & 0x20)
-            y += 9;
-        if(b[0] & 0x10)
-            y -= 9;
-        if(b[1] & 0x01)
-            x += 3;
-        if(b[1] & 0x02)
-            x -= 3;
-        if(b[1] & 0x04)
-            x += 27;
-        if(b[1] & 0x08)
-            x -= 27;
-        if(b[1] & 0x80)
-            y += 3;
-        if(b[1] & 0x40)
-            y -= 3;
-        if(b[1] & 0x20)
-            y += 27;
-        if(b[1] & 0x10)
-            y -= 27;
-        if(b[2] & 0x04)
-            x += 81;
-        if(b[2] & 0x08)
-            x -= 81;
-        if(b[2] & 0x20)
-            y += 81;
-        if(b[2] & 0x10)
-            y -= 81;
-        flags = decode_record_flags(b[2]);
         if(flags == END)
         {
             break;
         }
-        embPattern_addStitchRel(pattern, x / 10.0, y / 10.0, flags, 1);
+        embPattern_addStitchRel(pattern, dx / 10.0, dy / 10.0, flags, 1);
     }
     embFile_close(file);
 
     /* Check for an END stitch and add one if it is not present */
-    if(pattern->lastStitch->stitch.flags != END)
-        embPattern_addStitchRel(pattern, 0, 0, END, 1);
+    embPattern_end(pattern);
 
     /* combineJumpStitches(pattern, 5); */
     return 1;
@@ -397,25 +465,24 @@ int writeDst(EmbPattern* pattern, const char* fileName)
 {
     EmbRect boundingRect;
     EmbFile* file = 0;
-    int xx, yy, dx, dy, flags;
+    int xx, yy, dx, dy;
     int i;
     int co = 1, st = 0;
     int ax, ay, mx, my;
     char* pd = 0;
-    EmbStitchList* pointer = 0;
+    EmbStitchArray* stitches = 0;
 
     if(!pattern) { embLog_error("format-dst.c writeDst(), pattern argument is null\n"); return 0; }
     if(!fileName) { embLog_error("format-dst.c writeDst(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
         embLog_error("format-dst.c writeDst(), pattern contains no stitches\n");
         return 0;
     }
 
     /* Check for an END stitch and add one if it is not present */
-    if(pattern->lastStitch->stitch.flags != END)
-        embPattern_addStitchRel(pattern, 0, 0, END, 1);
+    embPattern_end(pattern);
 
     file = embFile_open(fileName, "wb");
     if(!file)
@@ -430,8 +497,7 @@ int writeDst(EmbPattern* pattern, const char* fileName)
     co = 1;
     co = embThreadList_count(pattern->threadList);
     st = 0;
-    st = embStitchList_count(pattern->stitchList);
-    flags = NORMAL;
+    st = embPattern_stitchCount(pattern);
     boundingRect = embPattern_calcBoundingBox(pattern);
     /* TODO: review the code below
     if(pattern->get_variable("design_name") != NULL)
@@ -482,20 +548,24 @@ int writeDst(EmbPattern* pattern, const char* fileName)
         embFile_printf(file, " ");
     }
 
-    /* write stitches */
+    /* write stitches, converted from mm to 0.1mm for file format */
+    stitches = embPattern_getStitchArray(pattern);
+    if(!stitches)
+    {
+        embFile_close(file);
+        return 0;
+    }
     xx = yy = 0;
-    pointer = pattern->stitchList;
-    while(pointer)
+    for(i = 0; i < stitches->count; i++)
     {
-        /* convert from mm to 0.1mm for file format */
-        dx = roundDouble(pointer->stitch.xx * 10.0) - xx;
-        dy = roundDouble(pointer->stitch.yy * 10.0) - yy;
-        xx = roundDouble(pointer->stitch.xx * 10.0);
-        yy = roundDouble(pointer->stitch.yy * 10.0);
-        flags = pointer->stitch.flags;
-        encode_record(file, dx, dy, flags);
-        pointer = pointer->next;
+        const EmbStitchFixed* s = &stitches->stitch[i];
+        dx = s->x - xx;
+        dy = s->y - yy;
+        xx = s->x;
+        yy = s->y;
+        encode_record(file, dx, dy, s->flags);
     }
+    embPattern_freeStitchArray(pattern, stitches);
     binaryWriteByte(file, 0xA1); /* finish file with a terminator character */
     binaryWriteShort(file, 0);
     embFile_close(file);
@@ -2,7 +2,9 @@
 #ifndef FORMAT_DST_H
 #define FORMAT_DST_H
 
+#include "emb-file.h"
 #include "emb-pattern.h"
+#include "emb-stitch-reader.h"
 
 #include "api-start.h"
 #ifdef __cplusplus
@@ -11,6 +13,8 @@ extern "C" {
 
 extern EMB_PRIVATE int EMB_CALL readDst(EmbPattern* pattern, const char* fileName);
 extern EMB_PRIVATE int EMB_CALL writeDst(EmbPattern* pattern, const char* fileName);
+extern EMB_PRIVATE int EMB_CALL readDstInfo(EmbFile* file, EmbPatternInfo* info);
+extern EMB_PRIVATE int EMB_CALL readDstStitch(EmbFile* file, int* dx, int* dy, int* flags);
 
 #ifdef __cplusplus
 }
@@ -510,18 +510,18 @@ int readDxf(EmbPattern* pattern, const char* fileName)
                 else if(!strcmp(buff,"42")) /* Bulge */
                 {
                     buff = readLine(file);
-                    bulge = atof(buff);
+                    bulge = emb_strtod(buff, 0);
                     bulgeFlag = 1;
                 }
                 else if(!strcmp(buff,"10")) /* X */
                 {
                     buff = readLine(file);
-                    x = atof(buff);
+                    x = emb_strtod(buff, 0);
                 }
                 else if(!strcmp(buff,"20")) /* Y */
                 {
                     buff = readLine(file);
-                    y = atof(buff);
+                    y = emb_strtod(buff, 0);
 
                     if(bulgeFlag)
                     {
@@ -9,6 +9,10 @@
 #include <math.h>
 #include <limits.h>
 
+#ifdef EMB_USE_PTHREADS
+#include <pthread.h>
+#endif
+
 /*TODO: 'husDecode' is defined but not used. Either remove it or use it. */
 /*
 static short husDecode(unsigned char a1, unsigned char a2)
@@ -50,22 +54,78 @@ static unsigned char* husDecompressData(unsigned char* input, int compressedInpu
     return decompressedData;
 }
 
+/* Does not log, it may run on a worker thread that has no EmbContext bound.
+ * Returns 0 if the output buffer cannot be allocated. */
 static unsigned char* husCompressData(unsigned char* input, int decompressedInputSize, int* compressedSize)
 {
     unsigned char* compressedData = (unsigned char*)malloc(sizeof(unsigned char)*decompressedInputSize*2);
-    if(!compressedData) { embLog_error("format-hus.c husCompressData(), cannot allocate memory for compressedData\n"); return 0; }
+    if(!compressedData) return 0;
     *compressedSize = husCompress(input, (unsigned long) decompressedInputSize, compressedData, 10, 0);
     return compressedData;
 }
 
+/* One independent byte stream of a HUS file and its compressed form.
+ * A failed job has output == 0 and failed set, husCompressJobs logs it. */
+typedef struct HusCompressJob_
+{
+    unsigned char* input;
+    int inputSize;
+    unsigned char* output;
+    int outputSize;
+    int failed;
+} HusCompressJob;
+
+static void* husCompressJob_run(void* arg)
+{
+    HusCompressJob* job = (HusCompressJob*)arg;
+    job->output = husCompressData(job->input, job->inputSize, &job->outputSize);
+    job->failed = !job->output;
+    return 0;
+}
+
+/* Compresses each job in \a jobs. The streams share no state, so when
+ * pthreads are available every job but the first runs on its own thread
+ * while the calling thread compresses the first one. Failures are logged
+ * here after the workers are joined, so they reach the context of the
+ * calling thread. */
+static void husCompressJobs(HusCompressJob* jobs, int jobCount)
+{
+    int i;
+#ifdef EMB_USE_PTHREADS
+    pthread_t threads[3];
+    int started[3] = { 0, 0, 0 };
+
+    if(jobCount > 3) jobCount = 3;
+    for(i = 1; i < jobCount; i++)
+    {
+        started[i] = (pthread_create(&threads[i], 0, husCompressJob_run, &jobs[i]) == 0);
+        if(!started[i]) husCompressJob_run(&jobs[i]);
+    }
+    husCompressJob_run(&jobs[0]);
+    for(i = 1; i < jobCount; i++)
+    {
+        if(started[i]) pthread_join(threads[i], 0);
+    }
+#else
+    for(i = 0; i < jobCount; i++)
+    {
+        husCompressJob_run(&jobs[i]);
+    }
+#endif
+    for(i = 0; i < jobCount; i++)
+    {
+        if(jobs[i].failed) embLog_error("format-hus.c husCompressJobs(), cannot allocate memory for compressed stream %d\n", i);
+    }
+}
+
 static int husDecodeByte(unsigned char b)
 {
     return (char)b;
 }
 
-static unsigned char husEncodeByte(double f)
+static unsigned char husEncodeByte(int delta)
 {
-    return (unsigned char)(int)roundDouble(f);
+    return (unsigned char)delta;
 }
 
 static unsigned char husEncodeStitchType(int st)
@@ -179,8 +239,7 @@ int readHus(EmbPattern* pattern, const char* fileName)
     embFile_close(file);
 
     /* Check for an END stitch and add one if it is not present */
-    if(pattern->lastStitch->stitch.flags != END)
-        embPattern_addStitchRel(pattern, 0, 0, END, 1);
+    embPattern_end(pattern);
 
     return 1;
 }
@@ -194,21 +253,19 @@ int writeHus(EmbPattern* pattern, const char* fileName)
     int attributeSize = 0;
     int xCompressedSize = 0;
     int yCompressedSize = 0;
-    double previousX = 0;
-    double previousY = 0;
+    int previousX = 0;
+    int previousY = 0;
     unsigned char* xValues = 0, *yValues = 0, *attributeValues = 0;
-    EmbStitchList* pointer = 0;
-    double xx = 0.0;
-    double yy = 0.0;
-    int flags = 0;
+    EmbStitchArray* stitches = 0;
     int i = 0;
-    unsigned char* attributeCompressed = 0, *xCompressed = 0, *yCompressed = 0;
+    HusCompressJob jobs[3];
+    EmbThreadPalette palette;
     EmbFile* file = 0;
 
     if(!pattern) { embLog_error("format-hus.c writeHus(), pattern argument is null\n"); return 0; }
     if(!fileName) { embLog_error("format-hus.c writeHus(), fileName argument is null\n"); return 0; }
 
-    stitchCount = embStitchList_count(pattern->stitchList);
+    stitchCount = embPattern_stitchCount(pattern);
     if(!stitchCount)
     {
         embLog_error("format-hus.c writeHus(), pattern contains no stitches\n");
@@ -216,16 +273,69 @@ int writeHus(EmbPattern* pattern, const char* fileName)
     }
 
     /* Check for an END stitch and add one if it is not present */
-    if(pattern->lastStitch->stitch.flags != END)
+    embPattern_end(pattern);
+
+    stitches = embPattern_getStitchArray(pattern);
+    if(!stitches) return 0;
+    stitchCount = stitches->count;
+
+    xValues = (unsigned char*)malloc(sizeof(unsigned char)*(stitchCount));
+    yValues = (unsigned char*)malloc(sizeof(unsigned char)*(stitchCount));
+    attributeValues = (unsigned char*)malloc(sizeof(unsigned char)*(stitchCount));
+    if(!xValues || !yValues || !attributeValues)
     {
-        embPattern_addStitchRel(pattern, 0, 0, END, 1);
-        stitchCount++;
+        embLog_error("format-hus.c writeHus(), cannot allocate memory for stitch values\n");
+        free(xValues);
+        free(yValues);
+        free(attributeValues);
+        embPattern_freeStitchArray(pattern, stitches);
+        return 0;
+    }
+
+    for(i = 0; i < stitches->count; i++)
+    {
+        const EmbStitchFixed* s = &stitches->stitch[i];
+        xValues[i] = husEncodeByte(s->x - previousX);
+        previousX = s->x;
+        yValues[i] = husEncodeByte(s->y - previousY);
+        previousY = s->y;
+        attributeValues[i] = husEncodeStitchType(s->flags);
+    }
+    embPattern_freeStitchArray(pattern, stitches);
+    stitches = 0;
+
+    /* Compress all three streams before anything is written,
+     * so the header offsets are known up front */
+    jobs[0].input = attributeValues;
+    jobs[1].input = xValues;
+    jobs[2].input = yValues;
+    for(i = 0; i < 3; i++)
+    {
+        jobs[i].inputSize = stitchCount;
+        jobs[i].output = 0;
+        jobs[i].outputSize = 0;
+        jobs[i].failed = 0;
+    }
+    husCompressJobs(jobs, 3);
+    attributeSize = jobs[0].outputSize;
+    xCompressedSize = jobs[1].outputSize;
+    yCompressedSize = jobs[2].outputSize;
+
+    free(xValues); xValues = 0;
+    free(yValues); yValues = 0;
+    free(attributeValues); attributeValues = 0;
+
+    if(!jobs[0].output || !jobs[1].output || !jobs[2].output)
+    {
+        for(i = 0; i < 3; i++) free(jobs[i].output);
+        return 0;
     }
 
     file = embFile_open(fileName, "wb");
     if(!file)
     {
         embLog_error("format-hus.c writeHus(), cannot open %s for writing\n", fileName);
+        for(i = 0; i < 3; i++) free(jobs[i].output);
         return 0;
     }
 
@@ -244,54 +354,26 @@ int writeHus(EmbPattern* pattern, const char* fileName)
     binaryWriteShort(file, (short) -roundDouble(boundingRect.bottom * 10.0 - 1.0));
 
     binaryWriteUInt(file, 0x2A + 2 * minColors);
-
-    xValues = (unsigned char*)malloc(sizeof(unsigned char)*(stitchCount));
-    if(!xValues) { embLog_error("format-hus.c writeHus(), cannot allocate memory for xValues\n"); return 0; }
-    yValues = (unsigned char*)malloc(sizeof(unsigned char)*(stitchCount));
-    if(!yValues) { embLog_error("format-hus.c writeHus(), cannot allocate memory for yValues\n"); return 0; }
-    attributeValues = (unsigned char*)malloc(sizeof(unsigned char)*(stitchCount));
-    if(!attributeValues) { embLog_error("format-hus.c writeHus(), cannot allocate memory for attributeValues\n"); return 0; }
-
-    pointer = pattern->stitchList;
-    while(pointer)
-    {
-        xx = pointer->stitch.xx;
-        yy = pointer->stitch.yy;
-        flags = pointer->stitch.flags;
-        xValues[i] = husEncodeByte((xx - previousX) * 10.0);
-        previousX = xx;
-        yValues[i] = husEncodeByte((yy - previousY) * 10.0);
-        previousY = yy;
-        attributeValues[i] = husEncodeStitchType(flags);
-        pointer = pointer->next;
-        i++;
-    }
-    attributeCompressed = husCompressData(attributeValues, stitchCount, &attributeSize);
-    xCompressed = husCompressData(xValues, stitchCount, &xCompressedSize);
-    yCompressed = husCompressData(yValues, stitchCount, &yCompressedSize);
-    /* TODO: error if husCompressData returns zero? */
-
     binaryWriteUInt(file, (unsigned int) (0x2A + 2 * patternColor + attributeSize));
     binaryWriteUInt(file, (unsigned int) (0x2A + 2 * patternColor + attributeSize + xCompressedSize));
     binaryWriteUInt(file, 0x00000000);
     binaryWriteUInt(file, 0x00000000);
     binaryWriteUShort(file, 0x0000);
 
+    embThreadPalette_init(&palette, husThreads, husThreadCount);
     for(i = 0; i < patternColor; i++)
     {
-        binaryWriteShort(file, (short)embThread_findNearestColorInArray(embThreadList_getAt(pattern->threadList, i).color, (EmbThread*)husThreads, husThreadCount));
+        binaryWriteShort(file, (short)embThreadPalette_findNearest(&palette, embThreadList_getAt(pattern->threadList, i).color));
     }
 
-    binaryWriteBytes(file, (char*) attributeCompressed, attributeSize);
-    binaryWriteBytes(file, (char*) xCompressed, xCompressedSize);
-    binaryWriteBytes(file, (char*) yCompressed, yCompressedSize);
+    binaryWriteBytes(file, (char*) jobs[0].output, attributeSize);
+    binaryWriteBytes(file, (char*) jobs[1].output, xCompressedSize);
+    binaryWriteBytes(file, (char*) jobs[2].output, yCompressedSize);
 
-    free(xValues); xValues = 0;
-    free(xCompressed); xCompressed = 0;
-    free(yValues); yValues = 0;
-    free(yCompressed); yCompressed = 0;
-    free(attributeValues); attributeValues = 0;
-    free(attributeCompressed); attributeCompressed = 0;
+    for(i = 0; i < 3; i++)
+    {
+        free(jobs[i].output); jobs[i].output = 0;
+    }
 
     embFile_close(file);
     return 1;
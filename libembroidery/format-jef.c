@@ -6,6 +6,7 @@
 #include "helpers-misc.h"
 #include "emb-stitch.h"
 #include <stdio.h>
+#include <stdlib.h>
 
 
 #define HOOP_126X110 0
@@ -184,46 +185,64 @@ int readJef(EmbPattern* pattern, const char* fileName)
     embFile_close(file);
 
     /* Check for an END stitch and add one if it is not present */
-    if (pattern->lastStitch->stitch.flags != END)
-    {
-        embPattern_addStitchRel(pattern, 0, 0, END, 1);
-    }
+    embPattern_end(pattern);
     return 1;
 }
 
-static void jefEncode(unsigned char* b, char dx, char dy, int flags)
+/* Encodes all \a stitches into \a out, which must hold at least
+ * 4 bytes per stitch. Returns the number of bytes written. */
+static int jefEncodeStitches(const EmbStitchArray* stitches, unsigned char* out)
 {
-    if(!b)
-    {
-        embLog_error("format-jef.c expEncode(), b argument is null\n");
-        return;
-    }
-    if(flags == STOP)
-    {
-        b[0] = 0x80;
-        b[1] = 1;
-        b[2] = dx;
-        b[3] = dy;
-    }
-    else if (flags == END)
-    {
-        b[0] = 0x80;
-        b[1] = 0x10;
-        b[2] = 0;
-        b[3] = 0;
-    }
-    else if(flags == TRIM || flags == JUMP)
-    {
-        b[0] = 0x80;
-        b[1] = 2;
-        b[2] = dx;
-        b[3] = dy;
-    }
-    else
+    unsigned char* b = out;
+    int xx = 0, yy = 0;
+    int i;
+
+    for(i = 0; i < stitches->count; i++)
     {
-        b[0] = dx;
-        b[1] = dy;
+        const EmbStitchFixed* s = &stitches->stitch[i];
+        unsigned char dx = (unsigned char)(s->x - xx);
+        unsigned char dy = (unsigned char)(s->y - yy);
+        xx = s->x;
+        yy = s->y;
+
+        if(s->flags & END)
+        {
+            *b++ = 0x80;
+            *b++ = 0x10;
+            *b++ = 0;
+            *b++ = 0;
+        }
+        else if(s->flags & STOP)
+        {
+            *b++ = 0x80;
+            *b++ = 1;
+            *b++ = dx;
+            *b++ = dy;
+        }
+        else if(s->flags & (TRIM | JUMP))
+        {
+            *b++ = 0x80;
+            *b++ = 2;
+            *b++ = dx;
+            *b++ = dy;
+        }
+        else
+        {
+            *b++ = dx;
+            *b++ = dy;
+        }
     }
+    return (int)(b - out);
+}
+
+/* Writes the four distances of a design of \a designWidth x \a designHeight
+ * (0.1mm) from the edges of a hoop of \a hoopWidth x \a hoopHeight. */
+static void jefWriteHoopDistance(EmbFile* file, int hoopWidth, int hoopHeight, int designWidth, int designHeight)
+{
+    binaryWriteInt(file, hoopWidth - designWidth / 2);   /* left */
+    binaryWriteInt(file, hoopHeight - designHeight / 2); /* top */
+    binaryWriteInt(file, hoopWidth - designWidth / 2);   /* right */
+    binaryWriteInt(file, hoopHeight - designHeight / 2); /* bottom */
 }
 
 /*! Writes the data from \a pattern to a file with the given \a fileName.
@@ -231,39 +250,66 @@ static void jefEncode(unsigned char* b, char dx, char dy, int flags)
 int writeJef(EmbPattern* pattern, const char* fileName)
 {
     int colorlistSize, minColors, designWidth, designHeight, i;
-    EmbRect boundingRect;
+    int left, top, right, bottom;
+    int stitchBytes;
     EmbFile* file = 0;
     EmbTime time;
     EmbThreadList* threadPointer = 0;
-    EmbStitchList* stitches = 0;
-    double dx = 0.0, dy = 0.0;
-    double xx = 0.0, yy = 0.0;
-    int flags = 0;
-    unsigned char b[4];
+    EmbStitchArray* stitches = 0;
+    unsigned char* stitchData = 0;
 
     if(!pattern) { embLog_error("format-jef.c writeJef(), pattern argument is null\n"); return 0; }
     if(!fileName) { embLog_error("format-jef.c writeJef(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
         embLog_error("format-jef.c writeJef(), pattern contains no stitches\n");
         return 0;
     }
 
     /* Check for an END stitch and add one if it is not present */
-    if (pattern->lastStitch->stitch.flags != END)
+    embPattern_end(pattern);
+
+    embPattern_correctForMaxStitchLength(pattern, 12.7, 12.7);
+
+    /* Quantize once, then gather the header stats and encode the whole
+     * stitch stream into one block before anything is written */
+    stitches = embPattern_getStitchArray(pattern);
+    if(!stitches) return 0;
+
+    left = top = 999999;
+    right = bottom = -999999;
+    for(i = 0; i < stitches->count; i++)
     {
-        embPattern_addStitchRel(pattern, 0, 0, END, 1);
+        const EmbStitchFixed* s = &stitches->stitch[i];
+        if(s->flags & TRIM) continue;
+        if(s->x < left) left = s->x;
+        if(s->x > right) right = s->x;
+        if(s->y < top) top = s->y;
+        if(s->y > bottom) bottom = s->y;
     }
+    if(left > right) { left = right = top = bottom = 0; }
+    designWidth = right - left;
+    designHeight = bottom - top;
+
+    stitchData = (unsigned char*)malloc(sizeof(unsigned char) * 4 * stitches->count);
+    if(!stitchData)
+    {
+        embLog_error("format-jef.c writeJef(), cannot allocate memory for stitchData\n");
+        embPattern_freeStitchArray(pattern, stitches);
+        return 0;
+    }
+    stitchBytes = jefEncodeStitches(stitches, stitchData);
+
     file = embFile_open(fileName, "wb");
     if(!file)
     {
         embLog_error("format-jef.c writeJef(), cannot open %s for writing\n", fileName);
+        free(stitchData);
+        embPattern_freeStitchArray(pattern, stitches);
         return 0;
     }
 
-    embPattern_correctForMaxStitchLength(pattern, 12.7, 12.7);
-
     colorlistSize = embThreadList_count(pattern->threadList);
     minColors = max(colorlistSize, 6);
     binaryWriteInt(file, 0x74 + (minColors * 4));
@@ -276,29 +322,21 @@ int writeJef(EmbPattern* pattern, const char* fileName)
             (int)(time.minute), (int)(time.second));
     binaryWriteByte(file, 0x00);
     binaryWriteByte(file, 0x00);
-    binaryWriteInt(file, embThreadList_count(pattern->threadList));
-    binaryWriteInt(file, embStitchList_count(pattern->stitchList) + max(0, (6 - colorlistSize) * 2) + 1);
-
-    boundingRect = embPattern_calcBoundingBox(pattern);
-
-    designWidth = (int)(embRect_width(boundingRect) * 10.0);
-    designHeight = (int)(embRect_width(boundingRect) * 10.0);
+    binaryWriteInt(file, colorlistSize);
+    binaryWriteInt(file, stitches->count + max(0, (6 - colorlistSize) * 2) + 1);
 
     binaryWriteInt(file, jefGetHoopSize(designWidth, designHeight));
 
     /* Distance from center of Hoop */
-    binaryWriteInt(file, (int) (designWidth / 2));  /* left */
-    binaryWriteInt(file, (int) (designHeight / 2)); /* top */
-    binaryWriteInt(file, (int) (designWidth / 2));  /* right */
-    binaryWriteInt(file, (int) (designHeight / 2)); /* bottom */
+    binaryWriteInt(file, designWidth / 2);  /* left */
+    binaryWriteInt(file, designHeight / 2); /* top */
+    binaryWriteInt(file, designWidth / 2);  /* right */
+    binaryWriteInt(file, designHeight / 2); /* bottom */
 
     /* Distance from default 110 x 110 Hoop */
     if(min(550 - designWidth / 2, 550 - designHeight / 2) >= 0)
     {
-        binaryWriteInt(file, (int) max(-1, 550 - designWidth / 2));  /* left */
-        binaryWriteInt(file, (int) max(-1, 550 - designHeight / 2)); /* top */
-        binaryWriteInt(file, (int) max(-1, 550 - designWidth / 2));  /* right */
-        binaryWriteInt(file, (int) max(-1, 550 - designHeight / 2)); /* bottom */
+        jefWriteHoopDistance(file, 550, 550, designWidth, designHeight);
     }
     else
     {
@@ -311,10 +349,7 @@ int writeJef(EmbPattern* pattern, const char* fileName)
     /* Distance from default 50 x 50 Hoop */
     if(min(250 - designWidth / 2, 250 - designHeight / 2) >= 0)
     {
-        binaryWriteInt(file, (int) max(-1, 250 - designWidth / 2));  /* left */
-        binaryWriteInt(file, (int) max(-1, 250 - designHeight / 2)); /* top */
-        binaryWriteInt(file, (int) max(-1, 250 - designWidth / 2));  /* right */
-        binaryWriteInt(file, (int) max(-1, 250 - designHeight / 2)); /* bottom */
+        jefWriteHoopDistance(file, 250, 250, designWidth, designHeight);
     }
     else
     {
@@ -325,17 +360,11 @@ int writeJef(EmbPattern* pattern, const char* fileName)
     }
 
     /* Distance from default 140 x 200 Hoop */
-    binaryWriteInt(file, (int) (700 - designWidth / 2));   /* left */
-    binaryWriteInt(file, (int) (1000 - designHeight / 2)); /* top */
-    binaryWriteInt(file, (int) (700 - designWidth / 2));   /* right */
-    binaryWriteInt(file, (int) (1000 - designHeight / 2)); /* bottom */
+    jefWriteHoopDistance(file, 700, 1000, designWidth, designHeight);
 
     /* repeated Distance from default 140 x 200 Hoop */
     /* TODO: Actually should be distance to custom hoop */
-    binaryWriteInt(file, (int) (630 - designWidth / 2));  /* left */
-    binaryWriteInt(file, (int) (550 - designHeight / 2)); /* top */
-    binaryWriteInt(file, (int) (630 - designWidth / 2));  /* right */
-    binaryWriteInt(file, (int) (550 - designHeight / 2)); /* bottom */
+    jefWriteHoopDistance(file, 630, 550, designWidth, designHeight);
 
     threadPointer = pattern->threadList;
 
@@ -348,25 +377,11 @@ int writeJef(EmbPattern* pattern, const char* fileName)
     {
         binaryWriteInt(file, 0x0D);
     }
-      stitches = pattern->stitchList;
-    while(stitches)
-    {
-        dx = stitches->stitch.xx * 10.0 - xx;
-        dy = stitches->stitch.yy * 10.0 - yy;
-        xx = stitches->stitch.xx * 10.0;
-        yy = stitches->stitch.yy * 10.0;
-        flags = stitches->stitch.flags;
-        jefEncode(b, (char)roundDouble(dx), (char)roundDouble(dy), flags);
-        if((b[0] == 0x80) && ((b[1] == 1) || (b[1] == 2) || (b[1] == 4) || (b[1] == 0x10)))
-        {
-            embFile_printf(file, "%c%c%c%c", b[0], b[1], b[2], b[3]);
-        }
-        else
-        {
-            embFile_printf(file, "%c%c", b[0], b[1]);
-        }
-        stitches = stitches->next;
-    }
+
+    embFile_write(stitchData, 1, (size_t)stitchBytes, file);
+
+    free(stitchData);
+    embPattern_freeStitchArray(pattern, stitches);
     embFile_close(file);
     return 1;
 }
@@ -6,71 +6,131 @@
 #include <stdlib.h>
 #include <string.h>
 
-void readPecStitches(EmbPattern* pattern, EmbFile* file)
+/*! Decodes the next stitch of the PEC stitch block in \a file into relative
+ *  \a dx, \a dy (0.1mm, y pointing down) and \a flags.
+ *  Returns \c false at the end of the file. */
+int readPecStitch(EmbFile* file, int* dx, int* dy, int* flags)
 {
-    int stitchNumber = 0;
+    int val1, val2;
 
-    if(!pattern) { embLog_error("format-pec.c readPecStitches(), pattern argument is null\n"); return; }
-    if(!file) { embLog_error("format-pec.c readPecStitches(), file argument is null\n"); return; }
+    if(embFile_eof(file))
+    {
+        return 0;
+    }
+    val1 = (int)binaryReadUInt8(file);
+    val2 = (int)binaryReadUInt8(file);
 
-    while(!embFile_eof(file))
+    *dx = 0;
+    *dy = 0;
+    *flags = NORMAL;
+    if(val1 == 0xFF && val2 == 0x00)
+    {
+        *flags = END;
+        return 1;
+    }
+    if(val1 == 0xFE && val2 == 0xB0)
     {
-        int val1 = (int)binaryReadUInt8(file);
-        int val2 = (int)binaryReadUInt8(file);
+        (void)binaryReadByte(file);
+        *flags = STOP;
+        return 1;
+    }
+    /* High bit set means 12-bit offset, otherwise 7-bit signed delta */
+    if(val1 & 0x80)
+    {
+        if(val1 & 0x20) *flags = TRIM;
+        if(val1 & 0x10) *flags = JUMP;
+        val1 = ((val1 & 0x0F) << 8) + val2;
 
-        int stitchType = NORMAL;
-        if(val1 == 0xFF && val2 == 0x00)
+        /* Signed 12-bit arithmetic */
+        if(val1 & 0x800)
         {
-            embPattern_addStitchRel(pattern, 0.0, 0.0, END, 1);
-            break;
+            val1 -= 0x1000;
         }
-        if(val1 == 0xFE && val2 == 0xB0)
-        {
-            (void)binaryReadByte(file);
-            embPattern_addStitchRel(pattern, 0.0, 0.0, STOP, 1);
-            stitchNumber++;
-            continue;
-        }
-        /* High bit set means 12-bit offset, otherwise 7-bit signed delta */
-        if(val1 & 0x80)
-        {
-            if(val1 & 0x20) stitchType = TRIM;
-            if(val1 & 0x10) stitchType = JUMP;
-            val1 = ((val1 & 0x0F) << 8) + val2;
 
-            /* Signed 12-bit arithmetic */
-            if(val1 & 0x800)
-            {
-                val1 -= 0x1000;
-            }
+        val2 = binaryReadUInt8(file);
+    }
+    else if(val1 >= 0x40)
+    {
+        val1 -= 0x80;
+    }
+    if(val2 & 0x80)
+    {
+        if(val2 & 0x20) *flags = TRIM;
+        if(val2 & 0x10) *flags = JUMP;
+        val2 = ((val2 & 0x0F) << 8) + binaryReadUInt8(file);
 
-            val2 = binaryReadUInt8(file);
-        }
-        else if(val1 >= 0x40)
+        /* Signed 12-bit arithmetic */
+        if(val2 & 0x800)
         {
-            val1 -= 0x80;
+            val2 -= 0x1000;
         }
-        if(val2 & 0x80)
-        {
-            if(val2 & 0x20) stitchType = TRIM;
-            if(val2 & 0x10) stitchType = JUMP;
-            val2 = ((val2 & 0x0F) << 8) + binaryReadUInt8(file);
+    }
+    else if(val2 >= 0x40)
+    {
+        val2 -= 0x80;
+    }
+    *dx = val1;
+    *dy = val2;
+    return 1;
+}
 
-            /* Signed 12-bit arithmetic */
-            if(val2 & 0x800)
-            {
-                val2 -= 0x1000;
-            }
-        }
-        else if(val2 >= 0x40)
+void readPecStitches(EmbPattern* pattern, EmbFile* file)
+{
+    int dx, dy, flags;
+
+    if(!pattern) { embLog_error("format-pec.c readPecStitches(), pattern argument is null\n"); return; }
+    if(!file) { embLog_error("format-pec.c readPecStitches(), file argument is null\n"); return; }
+
+    while(readPecStitch(file, &dx, &dy, &flags))
+    {
+        embPattern_addStitchRel(pattern, dx / 10.0, dy / 10.0, flags, 1);
+        if(flags == END)
         {
-            val2 -= 0x80;
+            break;
         }
-        embPattern_addStitchRel(pattern, val1 / 10.0, val2 / 10.0, stitchType, 1);
-        stitchNumber++;
     }
 }
 
+/*! Reads the header and color table of the PEC section starting at
+ *  \a pecStart into \a info, and leaves \a file positioned at the first
+ *  stitch. PEC does not record a stitch count, so it is set to -1.
+ *  Returns \c true if successful, otherwise returns \c false. */
+int readPecInfo(EmbFile* file, long pecStart, EmbPatternInfo* info)
+{
+    int i, width, height, bottom;
+
+    if(!file) { embLog_error("format-pec.c readPecInfo(), file argument is null\n"); return 0; }
+    if(!info) { embLog_error("format-pec.c readPecInfo(), info argument is null\n"); return 0; }
+
+    embFile_seek(file, pecStart + 0x30, SEEK_SET);
+    info->colorCount = binaryReadUInt8(file) + 1;
+    for(i = 0; i < info->colorCount; i++)
+    {
+        info->threads[i] = &pecThreads[binaryReadUInt8(file) % pecThreadCount];
+    }
+
+    /* Get X and Y size in .1 mm */
+    embFile_seek(file, pecStart + 0x208, SEEK_SET);
+    width = binaryReadInt16(file);
+    height = binaryReadInt16(file);
+    binaryReadInt16(file); /* 0x01E0 */
+    binaryReadInt16(file); /* 0x01B0 */
+    info->bounds.left = -(binaryReadUInt16BE(file) & 0x0FFF) / 10.0;
+    /* stored for the flipped design, so this is the extent above the start */
+    bottom = binaryReadUInt16BE(file) & 0x0FFF;
+    info->bounds.right = info->bounds.left + width / 10.0;
+    info->bounds.bottom = bottom / 10.0;
+    info->bounds.top = (bottom - height) / 10.0;
+    info->stitchCount = -1;
+
+    if(embFile_eof(file))
+    {
+        embLog_error("format-pec.c readPecInfo(), file is too short for a PEC header\n");
+        return 0;
+    }
+    return 1;
+}
+
 static void pecEncodeJump(EmbFile* file, int x, int types)
 {
     int outputVal = abs(x) & 0x7FF;
@@ -158,8 +218,7 @@ int readPec(EmbPattern* pattern, const char* fileName)
     embFile_close(file);
 
     /* Check for an END stitch and add one if it is not present */
-    if(pattern->lastStitch->stitch.flags != END)
-        embPattern_addStitchRel(pattern, 0, 0, END, 1);
+    embPattern_end(pattern);
 
     embPattern_flipVertical(pattern);
 
@@ -168,26 +227,30 @@ int readPec(EmbPattern* pattern, const char* fileName)
 
 static void pecEncode(EmbFile* file, EmbPattern* p)
 {
-    double thisX = 0.0;
-    double thisY = 0.0;
+    int thisX = 0;
+    int thisY = 0;
+    int i;
     unsigned char stopCode = 2;
-    EmbStitchList* list = 0;
+    EmbStitchArray* stitches = 0;
 
     if(!file) { embLog_error("format-pec.c pecEncode(), file argument is null\n"); return; }
     if(!p) { embLog_error("format-pec.c pecEncode(), p argument is null\n"); return; }
 
-    list = p->stitchList;
-    while(list)
+    /* the pattern is already scaled to 0.1mm by writePec()/writePes() */
+    stitches = embStitchArray_fromList(p->stitchList, 1.0);
+    if(!stitches) return;
+
+    for(i = 0; i < stitches->count; i++)
     {
         int deltaX, deltaY;
-        EmbStitch s = list->stitch;
+        const EmbStitchFixed* s = &stitches->stitch[i];
 
-        deltaX = roundDouble(s.xx - thisX);
-        deltaY = roundDouble(s.yy - thisY);
-        thisX += (double)deltaX;
-        thisY += (double)deltaY;
+        deltaX = s->x - thisX;
+        deltaY = s->y - thisY;
+        thisX = s->x;
+        thisY = s->y;
 
-        if(s.flags & STOP)
+        if(s->flags & STOP)
         {
             pecEncodeStop(file, stopCode);
             if(stopCode == (unsigned char)2)
@@ -199,23 +262,23 @@ static void pecEncode(EmbFile* file, EmbPattern* p)
                 stopCode = (unsigned char)2;
             }
         }
-        else if(s.flags & END)
+        else if(s->flags & END)
         {
             binaryWriteByte(file, 0xFF);
             break;
         }
-        else if(deltaX < 63 && deltaX > -64 && deltaY < 63 && deltaY > -64 && (!(s.flags & (JUMP | TRIM))))
+        else if(deltaX < 63 && deltaX > -64 && deltaY < 63 && deltaY > -64 && (!(s->flags & (JUMP | TRIM))))
         {
             binaryWriteByte(file, (deltaX < 0) ? (unsigned char)(deltaX + 0x80) : (unsigned char)deltaX);
             binaryWriteByte(file, (deltaY < 0) ? (unsigned char)(deltaY + 0x80) : (unsigned char)deltaY);
         }
         else
         {
-            pecEncodeJump(file, deltaX, s.flags);
-            pecEncodeJump(file, deltaY, s.flags);
+            pecEncodeJump(file, deltaX, s->flags);
+            pecEncodeJump(file, deltaY, s->flags);
         }
-        list = list->next;
     }
+    embStitchArray_free(stitches);
 }
 
 static void clearImage(unsigned char image[][48])
@@ -255,6 +318,7 @@ void writePecStitches(EmbPattern* pattern, EmbFile* file, const char* fileName)
     unsigned char image[38][48];
     int i, flen, currentThreadCount, graphicsOffsetLocation, graphicsOffsetValue, height, width;
     double xFactor, yFactor;
+    EmbThreadPalette palette;
     const char* forwardSlashPos = strrchr(fileName, '/');
     const char* backSlashPos = strrchr(fileName, '\\');
     const char* dotPos = strrchr(fileName, '.');
@@ -305,9 +369,10 @@ void writePecStitches(EmbPattern* pattern, EmbFile* file, const char* fileName)
     currentThreadCount = embThreadList_count(pattern->threadList);
     binaryWriteByte(file, (unsigned char)(currentThreadCount-1));
 
+    embThreadPalette_initMatch(&palette, pecThreads, pecThreadCount, EMB_THREAD_MATCH_LAB);
     for(i = 0; i < currentThreadCount; i++)
     {
-        binaryWriteByte(file, (unsigned char)embThread_findNearestColorInArray(embThreadList_getAt(pattern->threadList, i).color, (EmbThread*)pecThreads, pecThreadCount));
+        binaryWriteByte(file, (unsigned char)embThreadPalette_findNearest(&palette, embThreadList_getAt(pattern->threadList, i).color));
     }
     for(i = 0; i < (int)(0x1CF - currentThreadCount); i++)
     {
@@ -4,6 +4,7 @@
 
 #include "emb-file.h"
 #include "emb-pattern.h"
+#include "emb-stitch-reader.h"
 
 #include "api-start.h"
 #ifdef __cplusplus
@@ -13,6 +14,8 @@ extern "C" {
 extern EMB_PRIVATE int EMB_CALL readPec(EmbPattern* pattern, const char* fileName);
 extern EMB_PRIVATE int EMB_CALL writePec(EmbPattern* pattern, const char* fileName);
 extern EMB_PRIVATE void EMB_CALL readPecStitches(EmbPattern* pattern, EmbFile* file);
+extern EMB_PRIVATE int EMB_CALL readPecStitch(EmbFile* file, int* dx, int* dy, int* flags);
+extern EMB_PRIVATE int EMB_CALL readPecInfo(EmbFile* file, long pecStart, EmbPatternInfo* info);
 extern EMB_PRIVATE void EMB_CALL writePecStitches(EmbPattern* pattern, EmbFile* file, const char* filename);
 
 static const int pecThreadCount = 65;
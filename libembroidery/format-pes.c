@@ -38,14 +38,33 @@ int readPes(EmbPattern* pattern, const char* fileName)
     embFile_close(file);
 
     /* Check for an END stitch and add one if it is not present */
-    if(pattern->lastStitch->stitch.flags != END)
-        embPattern_addStitchRel(pattern, 0, 0, END, 1);
+    embPattern_end(pattern);
 
     embPattern_flipVertical(pattern);
 
     return 1;
 }
 
+/*! Reads only the PES header and the color table of its PEC section into
+ *  \a info, and leaves \a file positioned at the first stitch.
+ *  Returns \c true if successful, otherwise returns \c false. */
+int readPesInfo(EmbFile* file, EmbPatternInfo* info)
+{
+    int pecstart;
+
+    if(!file) { embLog_error("format-pes.c readPesInfo(), file argument is null\n"); return 0; }
+    if(!info) { embLog_error("format-pes.c readPesInfo(), info argument is null\n"); return 0; }
+
+    embFile_seek(file, 8, SEEK_SET);
+    pecstart = binaryReadInt32(file);
+    if(embFile_eof(file) || pecstart <= 0)
+    {
+        embLog_error("format-pes.c readPesInfo(), invalid PEC section offset\n");
+        return 0;
+    }
+    return readPecInfo(file, pecstart, info);
+}
+
 static void pesWriteSewSegSection(EmbPattern* pattern, EmbFile* file)
 {
     /* TODO: pointer safety */
@@ -63,14 +82,16 @@ static void pesWriteSewSegSection(EmbPattern* pattern, EmbFile* file)
     int i;
     EmbRect bounds = embPattern_calcBoundingBox(pattern);
     EmbColor color;
+    EmbThreadPalette palette;
 
+    embThreadPalette_initMatch(&palette, pecThreads, pecThreadCount, EMB_THREAD_MATCH_LAB);
     mainPointer = pattern->stitchList;
     while(mainPointer)
     {
         pointer = mainPointer;
         flag = pointer->stitch.flags;
         color = embThreadList_getAt(pattern->threadList, pointer->stitch.color).color;
-        newColorCode = embThread_findNearestColorInArray(color, (EmbThread*)pecThreads, pecThreadCount);
+        newColorCode = embThreadPalette_findNearest(&palette, color);
         if(newColorCode != colorCode)
         {
             colorCount++;
@@ -101,7 +122,7 @@ static void pesWriteSewSegSection(EmbPattern* pattern, EmbFile* file)
         pointer = mainPointer;
         flag = pointer->stitch.flags;
         color = embThreadList_getAt(pattern->threadList, pointer->stitch.color).color;
-        newColorCode = embThread_findNearestColorInArray(color, (EmbThread*)pecThreads, pecThreadCount);
+        newColorCode = embThreadPalette_findNearest(&palette, color);
         if(newColorCode != colorCode)
         {
             colorInfo[colorInfoIndex++] = (short)blockCount;
@@ -2,7 +2,9 @@
 #ifndef FORMAT_PES_H
 #define FORMAT_PES_H
 
+#include "emb-file.h"
 #include "emb-pattern.h"
+#include "emb-stitch-reader.h"
 
 #include "api-start.h"
 #ifdef __cplusplus
@@ -11,6 +13,7 @@ extern "C" {
 
 extern EMB_PRIVATE int EMB_CALL readPes(EmbPattern* pattern, const char* fileName);
 extern EMB_PRIVATE int EMB_CALL writePes(EmbPattern* pattern, const char* fileName);
+extern EMB_PRIVATE int EMB_CALL readPesInfo(EmbFile* file, EmbPatternInfo* info);
 
 #ifdef __cplusplus
 }
@@ -56,6 +56,21 @@ int readPlt(EmbPattern* pattern, const char* fileName)
     return 1;
 }
 
+/* Writes a pen \a command (PU or PD) to (\a x, \a y) in plotter units. */
+static void pltWriteCommand(FILE* file, const char* command, double x, double y)
+{
+    char buffer[2 * EMB_MAX_NUMBER_LENGTH + 8];
+    int length = 0;
+
+    buffer[length++] = command[0];
+    buffer[length++] = command[1];
+    length += emb_formatDouble(buffer + length, x, 6, 1);
+    buffer[length++] = ',';
+    length += emb_formatDouble(buffer + length, y, 6, 1);
+    buffer[length++] = ';';
+    fwrite(buffer, 1, length, file);
+}
+
 /*! Writes the data from \a pattern to a file with the given \a fileName.
  *  Returns \c true if successful, otherwise returns \c false. */
 int writePlt(EmbPattern* pattern, const char* fileName)
@@ -90,7 +105,7 @@ int writePlt(EmbPattern* pattern, const char* fileName)
         }
         if(firstStitchOfBlock)
         {
-            fprintf(file, "PU%f,%f;", stitch.xx * scalingFactor, stitch.yy * scalingFactor);
+            pltWriteCommand(file, "PU", stitch.xx * scalingFactor, stitch.yy * scalingFactor);
             fprintf(file, "ST0.00,0.00;");
             fprintf(file, "SP0;");
             fprintf(file, "HT0;");
@@ -101,7 +116,7 @@ int writePlt(EmbPattern* pattern, const char* fileName)
         }
         else
         {
-            fprintf(file, "PD%f,%f;", stitch.xx * scalingFactor, stitch.yy * scalingFactor);
+            pltWriteCommand(file, "PD", stitch.xx * scalingFactor, stitch.yy * scalingFactor);
         }
 
         pointer = pointer->next;
@@ -1,4 +1,5 @@
 #include "format-svg.h"
+#include "emb-context.h"
 #include "emb-file.h"
 #include "emb-logging.h"
 #include "helpers-misc.h"
@@ -6,7 +7,130 @@
 #include <stdlib.h>
 #include <string.h>
 
-EmbColor svgColorToEmbColor(char* colorString)
+typedef enum
+{
+    SVG_CREATOR_NULL,
+    SVG_CREATOR_EMBROIDERMODDER,
+    SVG_CREATOR_ILLUSTRATOR,
+    SVG_CREATOR_INKSCAPE
+} SVG_CREATOR;
+
+typedef enum
+{
+    SVG_NAME_ELEMENT,
+    SVG_NAME_ATTRIBUTE,
+    SVG_NAME_CREATOR
+} SVG_NAME_TYPE;
+
+/* Elements that svgAddToPattern() turns into objects, all others are skipped */
+typedef enum
+{
+    SVG_ELEMENT_CIRCLE,
+    SVG_ELEMENT_ELLIPSE,
+    SVG_ELEMENT_LINE,
+    SVG_ELEMENT_PATH,
+    SVG_ELEMENT_POLYGON,
+    SVG_ELEMENT_POLYLINE,
+    SVG_ELEMENT_RECT
+} SVG_ELEMENT_ID;
+
+/* Attributes that svgAddToPattern() reads, all others are skipped */
+typedef enum
+{
+    SVG_ATTRIBUTE_CX,
+    SVG_ATTRIBUTE_CY,
+    SVG_ATTRIBUTE_D,
+    SVG_ATTRIBUTE_HEIGHT,
+    SVG_ATTRIBUTE_POINTS,
+    SVG_ATTRIBUTE_R,
+    SVG_ATTRIBUTE_RX,
+    SVG_ATTRIBUTE_RY,
+    SVG_ATTRIBUTE_STROKE,
+    SVG_ATTRIBUTE_WIDTH,
+    SVG_ATTRIBUTE_X,
+    SVG_ATTRIBUTE_X1,
+    SVG_ATTRIBUTE_X2,
+    SVG_ATTRIBUTE_Y,
+    SVG_ATTRIBUTE_Y1,
+    SVG_ATTRIBUTE_Y2,
+    SVG_ATTRIBUTE_COUNT
+} SVG_ATTRIBUTE_ID;
+
+typedef struct SvgName_
+{
+    const char* name;
+    int type; /* SVG_NAME_TYPE */
+    int id;   /* SVG_ELEMENT_ID, SVG_ATTRIBUTE_ID or SVG_CREATOR */
+} SvgName;
+
+static const SvgName svgNames[] =
+{
+    { "circle",          SVG_NAME_ELEMENT,   SVG_ELEMENT_CIRCLE },
+    { "ellipse",         SVG_NAME_ELEMENT,   SVG_ELEMENT_ELLIPSE },
+    { "line",            SVG_NAME_ELEMENT,   SVG_ELEMENT_LINE },
+    { "path",            SVG_NAME_ELEMENT,   SVG_ELEMENT_PATH },
+    { "polygon",         SVG_NAME_ELEMENT,   SVG_ELEMENT_POLYGON },
+    { "polyline",        SVG_NAME_ELEMENT,   SVG_ELEMENT_POLYLINE },
+    { "rect",            SVG_NAME_ELEMENT,   SVG_ELEMENT_RECT },
+    /* Attempt to identify the program that created the SVG file. This should be in a comment that occurs before the svg element. */
+    { "Embroidermodder", SVG_NAME_CREATOR,   SVG_CREATOR_EMBROIDERMODDER },
+    { "Illustrator",     SVG_NAME_CREATOR,   SVG_CREATOR_ILLUSTRATOR },
+    { "Inkscape",        SVG_NAME_CREATOR,   SVG_CREATOR_INKSCAPE },
+    { "cx",              SVG_NAME_ATTRIBUTE, SVG_ATTRIBUTE_CX },
+    { "cy",              SVG_NAME_ATTRIBUTE, SVG_ATTRIBUTE_CY },
+    { "d",               SVG_NAME_ATTRIBUTE, SVG_ATTRIBUTE_D },
+    { "height",          SVG_NAME_ATTRIBUTE, SVG_ATTRIBUTE_HEIGHT },
+    { "points",          SVG_NAME_ATTRIBUTE, SVG_ATTRIBUTE_POINTS },
+    { "r",               SVG_NAME_ATTRIBUTE, SVG_ATTRIBUTE_R },
+    { "rx",              SVG_NAME_ATTRIBUTE, SVG_ATTRIBUTE_RX },
+    { "ry",              SVG_NAME_ATTRIBUTE, SVG_ATTRIBUTE_RY },
+    { "stroke",          SVG_NAME_ATTRIBUTE, SVG_ATTRIBUTE_STROKE },
+    { "width",           SVG_NAME_ATTRIBUTE, SVG_ATTRIBUTE_WIDTH },
+    { "x",               SVG_NAME_ATTRIBUTE, SVG_ATTRIBUTE_X },
+    { "x1",              SVG_NAME_ATTRIBUTE, SVG_ATTRIBUTE_X1 },
+    { "x2",              SVG_NAME_ATTRIBUTE, SVG_ATTRIBUTE_X2 },
+    { "y",               SVG_NAME_ATTRIBUTE, SVG_ATTRIBUTE_Y },
+    { "y1",              SVG_NAME_ATTRIBUTE, SVG_ATTRIBUTE_Y1 },
+    { "y2",              SVG_NAME_ATTRIBUTE, SVG_ATTRIBUTE_Y2 }
+};
+
+/* Perfect hash of svgNames: SVG_NAME_HASH() is different for every entry,
+ * svgNameSlots maps each hash to its svgNames index (-1 if unused).
+ * NOTE: when adding a name, pick new multipliers if it collides and regenerate the slots. */
+#define SVG_NAME_HASH(name, length) (((unsigned char)(name)[0] + 28 * (unsigned char)(name)[(length) - 1] + 10 * (length)) & 63)
+
+static const signed char svgNameSlots[64] =
+{
+    14, -1, 17, -1, 22, 25, -1, -1, -1, 19,  6, -1,  5, -1, -1, -1,
+    -1, -1, -1,  7, 13, -1, -1, 10, -1, -1, -1, -1, -1, -1, 12, -1,
+     2, -1, 20, -1, -1,  9, 16, -1, 21, 24, -1,  0, -1, -1, -1,  8,
+    -1, -1, -1, 11, 15, -1, -1,  1,  3, -1, -1, 18, -1, -1,  4, 23
+};
+
+/* State of one readSvg() call, so several files can be read at once */
+typedef struct SvgReader_
+{
+    EmbPattern* pattern;
+    int creator;                             /* SVG_CREATOR */
+    int element;                             /* SVG_ELEMENT_ID of the current tag, -1 if it is skipped */
+    const char* values[SVG_ATTRIBUTE_COUNT]; /* attribute values of the current tag, point into the file buffer */
+} SvgReader;
+
+/* Returns the id of the \a length characters at \a name if they are a known name of \a type, otherwise -1. */
+static int svgLookup(const char* name, int length, int type)
+{
+    const SvgName* entry = 0;
+    int slot;
+
+    if(length <= 0) return -1;
+    slot = svgNameSlots[SVG_NAME_HASH(name, length)];
+    if(slot < 0) return -1;
+    entry = &svgNames[slot];
+    if(entry->type != type || strncmp(entry->name, name, length) || entry->name[length] != '\0') return -1;
+    return entry->id;
+}
+
+EmbColor svgColorToEmbColor(const char* colorString)
 {
     unsigned char r = 0;
     unsigned char g = 0;
@@ -54,9 +178,9 @@ EmbColor svgColorToEmbColor(char* colorString)
             if(colorStr[i] == ')') colorStr[i] = ' ';
             if(colorStr[i] == '%') colorStr[i] = ' ';
         }
-        r = (unsigned char)roundDouble(255.0/100.0 * strtod(colorStr, &pEnd));
-        g = (unsigned char)roundDouble(255.0/100.0 * strtod(pEnd,     &pEnd));
-        b = (unsigned char)roundDouble(255.0/100.0 * strtod(pEnd,     &pEnd));
+        r = (unsigned char)roundDouble(255.0/100.0 * emb_strtod(colorStr, &pEnd));
+        g = (unsigned char)roundDouble(255.0/100.0 * emb_strtod(pEnd,     &pEnd));
+        b = (unsigned char)roundDouble(255.0/100.0 * emb_strtod(pEnd,     &pEnd));
     }
     else if(length > 3 && startsWith("rgb", colorStr)) /* Integer functional — rgb(rrr, ggg, bbb) */
     {
@@ -121,397 +245,179 @@ EmbFlag svgPathCmdToEmbPathFlag(char cmd)
     return LINETO;
 }
 
-SvgAttribute svgAttribute_create(const char* name, const char* value)
+static const char* svgAttribute_getValue(SvgReader* reader, int attribute)
 {
-    SvgAttribute attribute;
-    char* modValue = 0;
-    int last = 0;
-    int i = 0;
-
-    modValue = emb_strdup(value);
-    last = strlen(modValue);
-    for(i = 0; i < last; i++)
-    {
-        if(modValue[i] == '"') modValue[i] = ' ';
-        if(modValue[i] == '\'') modValue[i] = ' ';
-        if(modValue[i] == '/') modValue[i] = ' ';
-        if(modValue[i] == ',') modValue[i] = ' ';
-    }
-    attribute.name = emb_strdup(name);
-    attribute.value = modValue;
-    return attribute;
+    if(!reader->values[attribute]) return "none";
+    return reader->values[attribute];
 }
 
-void svgElement_addAttribute(SvgElement* element, SvgAttribute data)
+static void svgAddToPattern(SvgReader* reader)
 {
-    if(!element) { embLog_error("format-svg.c svgElement_addAttribute(), element argument is null\n"); return; }
+    EmbPattern* p = reader->pattern;
 
-    if(!(element->attributeList))
+    if(reader->element == SVG_ELEMENT_CIRCLE)
     {
-        element->attributeList = (SvgAttributeList*)malloc(sizeof(SvgAttributeList));
-        if(!(element->attributeList)) { embLog_error("format-svg.c svgElement_addAttribute(), cannot allocate memory for element->attributeList\n"); return; }
-        element->attributeList->attribute = data;
-        element->attributeList->next = 0;
-        element->lastAttribute = element->attributeList;
-        element->lastAttribute->next = 0;
+        embPattern_addCircleObjectAbs(p, emb_strtod(svgAttribute_getValue(reader, SVG_ATTRIBUTE_CX), 0),
+                                         emb_strtod(svgAttribute_getValue(reader, SVG_ATTRIBUTE_CY), 0),
+                                         emb_strtod(svgAttribute_getValue(reader, SVG_ATTRIBUTE_R), 0));
     }
-    else
+    else if(reader->element == SVG_ELEMENT_ELLIPSE)
     {
-        SvgAttributeList* pointerLast = element->lastAttribute;
-        SvgAttributeList* list = (SvgAttributeList*)malloc(sizeof(SvgAttributeList));
-        if(!list) { embLog_error("format-svg.c svgElement_addAttribute(), cannot allocate memory for list\n"); return; }
-        list->attribute = data;
-        list->next = 0;
-        pointerLast->next = list;
-        element->lastAttribute = list;
+        embPattern_addEllipseObjectAbs(p, emb_strtod(svgAttribute_getValue(reader, SVG_ATTRIBUTE_CX), 0),
+                                          emb_strtod(svgAttribute_getValue(reader, SVG_ATTRIBUTE_CY), 0),
+                                          emb_strtod(svgAttribute_getValue(reader, SVG_ATTRIBUTE_RX), 0),
+                                          emb_strtod(svgAttribute_getValue(reader, SVG_ATTRIBUTE_RY), 0));
     }
-}
-
-void svgElement_free(SvgElement* element)
-{
-    SvgAttributeList* list = 0;
-    SvgAttributeList* nextList = 0;
-    if(!element) return;
-
-    list = element->attributeList;
-
-    while(list)
+    else if(reader->element == SVG_ELEMENT_LINE)
     {
-        free(list->attribute.name);
-        list->attribute.name = 0;
-        free(list->attribute.value);
-        list->attribute.value = 0;
-        nextList = list->next;
-        free(list);
-        list = 0;
-        list = nextList;
-    }
-
-    element->lastAttribute = 0;
-    free(element->name);
-    element->name = 0;
-    free(element);
-    element = 0;
-}
-
-SvgElement* svgElement_create(const char* name)
-{
-    SvgElement* element = 0;
-
-    element = (SvgElement*)malloc(sizeof(SvgElement));
-    if(!element) { embLog_error("format-svg.c svgElement_create(), cannot allocate memory for element\n"); return 0; }
-    element->name = emb_strdup(name);
-    if(!element->name) { embLog_error("format-svg.c svgElement_create(), element->name is null\n"); return 0; }
-    element->attributeList = 0;
-    element->lastAttribute = 0;
-    return element;
-}
-
-char* svgAttribute_getValue(SvgElement* element, const char* name)
-{
-    SvgAttributeList* pointer = 0;
-
-    if(!element) { embLog_error("format-svg.c svgAttribute_getValue(), element argument is null\n"); return "none"; }
-    if(!name) { embLog_error("format-svg.c svgAttribute_getValue(), name argument is null\n"); return "none"; }
-    if(!element->attributeList) { /* TODO: error */ return "none"; }
-
-    pointer = element->attributeList;
-    while(pointer)
-    {
-        if(!strcmp(pointer->attribute.name, name)) { return pointer->attribute.value; }
-        pointer = pointer->next;
-    }
-
-    return "none";
-}
-
-void svgAddToPattern(EmbPattern* p)
-{
-    const char* buff = 0;
-
-    if(!p) { embLog_error("format-svg.c svgAddToPattern(), p argument is null\n"); return; }
-    if(!currentElement) { return; }
-
-    buff = currentElement->name;
-    if(!buff) { return; }
-
-    if     (!strcmp(buff, "?xml"))             {  }
-    else if(!strcmp(buff, "a"))                {  }
-    else if(!strcmp(buff, "animate"))          {  }
-    else if(!strcmp(buff, "animateColor"))     {  }
-    else if(!strcmp(buff, "animateMotion"))    {  }
-    else if(!strcmp(buff, "animateTransform")) {  }
-    else if(!strcmp(buff, "animation"))        {  }
-    else if(!strcmp(buff, "audio"))            {  }
-    else if(!strcmp(buff, "circle"))
-    {
-        embPattern_addCircleObjectAbs(p, atof(svgAttribute_getValue(currentElement, "cx")),
-                                         atof(svgAttribute_getValue(currentElement, "cy")),
-                                         atof(svgAttribute_getValue(currentElement, "r")));
-    }
-    else if(!strcmp(buff, "defs"))             {  }
-    else if(!strcmp(buff, "desc"))             {  }
-    else if(!strcmp(buff, "discard"))          {  }
-    else if(!strcmp(buff, "ellipse"))
-    {
-        embPattern_addEllipseObjectAbs(p, atof(svgAttribute_getValue(currentElement, "cx")),
-                                          atof(svgAttribute_getValue(currentElement, "cy")),
-                                          atof(svgAttribute_getValue(currentElement, "rx")),
-                                          atof(svgAttribute_getValue(currentElement, "ry")));
-    }
-    else if(!strcmp(buff, "font"))             {  }
-    else if(!strcmp(buff, "font-face"))        {  }
-    else if(!strcmp(buff, "font-face-src"))    {  }
-    else if(!strcmp(buff, "font-face-uri"))    {  }
-    else if(!strcmp(buff, "foreignObject"))    {  }
-    else if(!strcmp(buff, "g"))                {  }
-    else if(!strcmp(buff, "glyph"))            {  }
-    else if(!strcmp(buff, "handler"))          {  }
-    else if(!strcmp(buff, "hkern"))            {  }
-    else if(!strcmp(buff, "image"))            {  }
-    else if(!strcmp(buff, "line"))
-    {
-        char* x1 = svgAttribute_getValue(currentElement, "x1");
-        char* y1 = svgAttribute_getValue(currentElement, "y1");
-        char* x2 = svgAttribute_getValue(currentElement, "x2");
-        char* y2 = svgAttribute_getValue(currentElement, "y2");
+        const char* x1 = svgAttribute_getValue(reader, SVG_ATTRIBUTE_X1);
+        const char* y1 = svgAttribute_getValue(reader, SVG_ATTRIBUTE_Y1);
+        const char* x2 = svgAttribute_getValue(reader, SVG_ATTRIBUTE_X2);
+        const char* y2 = svgAttribute_getValue(reader, SVG_ATTRIBUTE_Y2);
 
         /* If the starting and ending points are the same, it is a point */
         if(!strcmp(x1, x2) && !strcmp(y1, y2))
-            embPattern_addPointObjectAbs(p, atof(x1), atof(y1));
+            embPattern_addPointObjectAbs(p, emb_strtod(x1, 0), emb_strtod(y1, 0));
         else
-            embPattern_addLineObjectAbs(p, atof(x1), atof(y1), atof(x2), atof(y2));
+            embPattern_addLineObjectAbs(p, emb_strtod(x1, 0), emb_strtod(y1, 0), emb_strtod(x2, 0), emb_strtod(y2, 0));
     }
-    else if(!strcmp(buff, "linearGradient"))   {  }
-    else if(!strcmp(buff, "listener"))         {  }
-    else if(!strcmp(buff, "metadata"))         {  }
-    else if(!strcmp(buff, "missing-glyph"))    {  }
-    else if(!strcmp(buff, "mpath"))            {  }
-    else if(!strcmp(buff, "path"))
+    else if(reader->element == SVG_ELEMENT_PATH)
     {
         /* TODO: finish */
 
-        char* pointStr = svgAttribute_getValue(currentElement, "d");
-        char* mystrok = svgAttribute_getValue(currentElement, "stroke");
+        const char* pointStr = svgAttribute_getValue(reader, SVG_ATTRIBUTE_D);
 
         int last = strlen(pointStr);
-        int size = 32;
         int i = 0;
-        int j = 0;
         int pos = 0;
         /* An odometer aka 'tripometer' used for stepping thru the pathData */
         int trip = -1; /* count of float[] that has been filled. 0=first item of array, -1=not filled = empty array */
-        int reset = -1;
+        int argCount = -1; /* numbers taken by cmd, -1 = no command, numbers are skipped */
         double xx = 0.0;
         double yy = 0.0;
+        double ox = 0.0;
+        double oy = 0.0;
         double fx = 0.0;
         double fy = 0.0;
         double lx = 0.0;
         double ly = 0.0;
-        double cx1 = 0.0, cx2 = 0.0;
-        double cy1 = 0.0, cy2 = 0.0;
         int cmd = 0;
         double pathData[7];
         unsigned int numMoves = 0;
-        int pendingTask = 0;
-        int relative = 0;
+        int point = 0;
+        char pathbuff[EMB_MAX_NUMBER_LENGTH];
 
         EmbPointList* startOfPointList = 0;
         EmbPointList* pathObjPointList = 0;
         EmbFlagList* startOfFlagList = 0;
         EmbFlagList* pathObjFlagList = 0;
 
-        char* pathbuff = 0;
-        pathbuff = (char*)malloc(size);
-        if(!pathbuff) { embLog_error("format-svg.c svgAddToPattern(), cannot allocate memory for pathbuff\n"); return; }
-
-        printf("stroke:%s\n", mystrok);
-
         /* M44.219,26.365c0,10.306-8.354,18.659-18.652,18.659c-10.299,0-18.663-8.354-18.663-18.659c0-10.305,8.354-18.659,18.659-18.659C35.867,7.707,44.219,16.06,44.219,26.365z */
-        for(i = 0; i < last; i++)
+        for(i = 0; i <= last; i++) /* the terminating 0 ends the last number */
         {
             char c = pointStr[i];
-            switch(c)
-            {
-                case '0':
-                case '1':
-                case '2':
-                case '3':
-                case '4':
-                case '5':
-                case '6':
-                case '7':
-                case '8':
-                case '9':
-                case '.':
-                    pathbuff[pos++] = (char)c;                  /* add a more char */
-                    break;
-
-                case ' ':
-                case ',':
-
-                    /*printf("    ,'%s'    ~POS=%d  ~TRIP=%d  ~[pos]=%d\n", pathbuff,pos,trip, pathbuff[pos]);*/
-                    if(pos > 0) {         /* append float to array, if it not yet stored */
-                        pathbuff[pos] = 0;
-                        pos = 0;
-                        printf("    ,val:%s\n", pathbuff);
-                        pathData[++trip] = atof(pathbuff);
-                    }
-                    break;
+            int isDigit = (c >= '0' && c <= '9') || c == '.';
 
-                case '-':
-
-                    if(pos > 0) {         /* append float to array, if it not yet stored */
-                        pathbuff[pos] = 0;
-                        pos = 0;
-                        printf("    -val:%s\n", pathbuff);
-                        pathData[++trip] = atof(pathbuff);
-                    }
-                    pathbuff[pos++] = (char)c;                  /* add a more char */
-                    break;
-
-                default:
-                    /*** ASSUMED ANY COMMAND FOUND ***/
-
-
-                    if(pos > 0) {         /* just make sure: append float to array, if it not yet stored */
-                        pathbuff[pos] = 0;
-                        pos = 0;
-                        printf("    >val:%s\n", pathbuff);
-                        pathData[++trip] = atof(pathbuff);
-                    }
-
-                    /**** Compose Point List ****/
-
-                    /* below "while" is for avoid loosing last 'z' command that maybe never accomodated. */
-                    pendingTask = 1; if (i==last-1) {pendingTask = 2;}
-
-                    while (pendingTask > 0)
-                    {
-                        pendingTask -= 1;
-
-                    /* Check wether prior command need to be saved */
-                    if(trip>=0)
-                    {
-                            trip = -1;
-                            reset = -1;
-
-                            relative = 0; /* relative to prior coordinate point or absolute coordinate? */
-
-                            if     (cmd == 'M') { xx = pathData[0]; yy = pathData[1]; fx = xx; fy = yy; }
-                            else if(cmd == 'm') { xx = pathData[0]; yy = pathData[1]; fx = xx; fy = yy; relative=1; }
-                            else if(cmd == 'L') { xx = pathData[0]; yy = pathData[1]; }
-                            else if(cmd == 'l') { xx = pathData[0]; yy = pathData[1]; relative=1;}
-                            else if(cmd == 'H') { xx = pathData[0]; yy = ly; }
-                            else if(cmd == 'h') { xx = pathData[0]; yy = ly; relative=1;}
-                            else if(cmd == 'V') { xx = lx;          yy = pathData[1]; }
-                            else if(cmd == 'v') { xx = lx;          yy = pathData[1]; relative=1;}
-                            else if(cmd == 'C') { xx = pathData[4]; yy = pathData[5]; cx1 = pathData[0]; cy1 = pathData[1]; cx2 = pathData[2]; cy2 = pathData[3]; }
-                            else if(cmd == 'c') { xx = pathData[4]; yy = pathData[5]; cx1 = pathData[0]; cy1 = pathData[1]; cx2 = pathData[2]; cy2 = pathData[3]; relative=1;}
-                            /*
-                            else if(cmd == 'S') { xx = pathData[0]; yy = pathData[1]; }
-                            else if(cmd == 's') { xx = pathData[0]; yy = pathData[1]; }
-                            else if(cmd == 'Q') { xx = pathData[0]; yy = pathData[1]; }
-                            else if(cmd == 'q') { xx = pathData[0]; yy = pathData[1]; }
-                            else if(cmd == 'T') { xx = pathData[0]; yy = pathData[1]; }
-                            else if(cmd == 't') { xx = pathData[0]; yy = pathData[1]; }
-                            else if(cmd == 'A') { xx = pathData[0]; yy = pathData[1]; }
-                            else if(cmd == 'a') { xx = pathData[0]; yy = pathData[1]; }
-                            */
-                            else if(cmd == 'Z') { xx = fx;          yy = fy; }
-                            else if(cmd == 'z') { xx = fx;          yy = fy; }
-
-                            if(!pathObjPointList && !pathObjFlagList)
-                            {
-                                pathObjPointList = embPointList_create(xx, yy);
-                                startOfPointList = pathObjPointList;
-                                pathObjFlagList = embFlagList_create(svgPathCmdToEmbPathFlag(cmd));
-                                startOfFlagList = pathObjFlagList;
-                            }
-                            else
-                            {
-                                pathObjPointList = embPointList_add(pathObjPointList, embPoint_make(xx, yy));
-                                pathObjFlagList = embFlagList_add(pathObjFlagList, svgPathCmdToEmbPathFlag(cmd));
-                            }
-                            lx = xx; ly = yy;
-
-                            pathbuff[0] = (char)cmd;                  /* set the command for compare */
-                            pathbuff[1] = 0;
-                            pos = 0;
-
-                            printf("*prior:%s (%f, %f,  %f, %f,     %f,%f,  %f) \n", pathbuff,
-                                   pathData[0],
-                                   pathData[1],
-                                   pathData[2],
-                                   pathData[3],
-                                   pathData[4],
-                                   pathData[5],
-                                   pathData[6]
-                                   );
-
-                    }
+            if(pos > 0 && (isDigit || c == 'e' || c == 'E' ||
+               ((c == '-' || c == '+') && (pathbuff[pos - 1] == 'e' || pathbuff[pos - 1] == 'E'))))
+            {
+                if(pos < (int)sizeof(pathbuff) - 1) pathbuff[pos++] = c; /* add a more char */
+                continue;
+            }
 
-                    /* assign new command */
-                    if(trip == -1 && reset == -1)
+            if(pos > 0) /* the number ends here, append it to pathData */
+            {
+                pathbuff[pos] = 0;
+                pos = 0;
+                if(argCount > 0)
+                {
+                    pathData[++trip] = emb_strtod(pathbuff, 0);
+                    if(trip + 1 == argCount)
                     {
-                        pathbuff[0] = (char)c;                  /* set the command for compare */
-                        pathbuff[1] = 0;
-
-                        printf("cmd:%s\n", pathbuff);
-                        if     (!strcmp(pathbuff, "M")) { cmd = 'M'; reset = 2; numMoves++; }
-                        else if(!strcmp(pathbuff, "m")) { cmd = 'm'; reset = 2; numMoves++; }
-                        else if(!strcmp(pathbuff, "L")) { cmd = 'L'; reset = 2; }
-                        else if(!strcmp(pathbuff, "l")) { cmd = 'l'; reset = 2; }
-                        else if(!strcmp(pathbuff, "C")) { cmd = 'C'; reset = 6; }
-                        else if(!strcmp(pathbuff, "c")) { cmd = 'c'; reset = 6; }
-                        else if(!strcmp(pathbuff, "H")) { cmd = 'H'; reset = 1; }
-                        else if(!strcmp(pathbuff, "h")) { cmd = 'h'; reset = 1; }
-                        else if(!strcmp(pathbuff, "V")) { cmd = 'V'; reset = 1; }
-                        else if(!strcmp(pathbuff, "v")) { cmd = 'v'; reset = 1; }
-                        else if(!strcmp(pathbuff, "S")) { cmd = 'S'; reset = 4; }
-                        else if(!strcmp(pathbuff, "s")) { cmd = 's'; reset = 4; }
-                        else if(!strcmp(pathbuff, "Q")) { cmd = 'Q'; reset = 4; }
-                        else if(!strcmp(pathbuff, "q")) { cmd = 'q'; reset = 4; }
-                        else if(!strcmp(pathbuff, "T")) { cmd = 'T'; reset = 2; }
-                        else if(!strcmp(pathbuff, "t")) { cmd = 't'; reset = 2; }
-                        else if(!strcmp(pathbuff, "A")) { cmd = 'A'; reset = 7; }
-                        else if(!strcmp(pathbuff, "a")) { cmd = 'a'; reset = 7; }
-                        else if(!strcmp(pathbuff, "Z")) { cmd = 'Z'; reset = 0; }
-                        else if(!strcmp(pathbuff, "z")) { cmd = 'z'; reset = 0; }
-                        else {
-                            embLog_error("format-svg.c svgAddToPattern(), %s is not a valid svg path command, skipping...\n", pathbuff);
-                            trip = -1;
-                            reset = -1;
+                        /* all arguments of cmd are read, repeated coordinates apply it again */
+                        trip = -1;
+                        ox = islower(cmd) ? lx : 0.0; /* relative to prior coordinate point or absolute coordinate? */
+                        oy = islower(cmd) ? ly : 0.0;
+                        switch(toupper(cmd))
+                        {
+                            case 'M': xx = ox + pathData[0]; yy = oy + pathData[1]; fx = xx; fy = yy; break;
+                            case 'H': xx = ox + pathData[0]; yy = ly; break;
+                            case 'V': xx = lx;               yy = oy + pathData[0]; break;
+                            /* TODO: curves and arcs are stored as lines to their end point */
+                            default:  xx = ox + pathData[argCount - 2]; yy = oy + pathData[argCount - 1]; break;
                         }
+                        point = 1;
                     }
-                    /* avoid loosing 'z' command that maybe never accomodated. */
-                        if (i==last-1) {
-                            trip = 2;
-                        }
-                    } /* while pendingTask */
-
+                }
+            }
 
-                    break;
+            if(isDigit || c == '-' || c == '+')
+            {
+                pathbuff[pos++] = (char)c;
             }
-            if(pos >= size - 1)
+            else if(c == ' ' || c == ',' || c == '\t' || c == '\r' || c == '\n' || c == 0)
             {
-                /* increase pathbuff length - leave room for 0 */
-                size *= 2;
-                pathbuff = (char*)realloc(pathbuff, size);
-                if(!pathbuff) { embLog_error("format-svg.c svgAddToPattern(), cannot re-allocate memory for pathbuff\n"); return; }
+                /* separator */
+            }
+            else
+            {
+                /*** ASSUMED ANY COMMAND FOUND ***/
+                if(trip >= 0)
+                {
+                    embLog_error("format-svg.c svgAddToPattern(), missing arguments of path command %c, skipping...\n", cmd);
+                    trip = -1;
+                }
+                cmd = c;
+                switch(c)
+                {
+                    case 'M': case 'm': argCount = 2; numMoves++; break;
+                    case 'L': case 'l': argCount = 2; break;
+                    case 'H': case 'h': argCount = 1; break;
+                    case 'V': case 'v': argCount = 1; break;
+                    case 'C': case 'c': argCount = 6; break;
+                    case 'S': case 's': argCount = 4; break;
+                    case 'Q': case 'q': argCount = 4; break;
+                    case 'T': case 't': argCount = 2; break;
+                    case 'A': case 'a': argCount = 7; break;
+                    case 'Z': case 'z': argCount = 0; xx = fx; yy = fy; point = 1; break;
+                    default:
+                        embLog_error("format-svg.c svgAddToPattern(), %c is not a valid svg path command, skipping...\n", c);
+                        argCount = -1;
+                        break;
+                }
+            }
+
+            /**** Compose Point List ****/
+            if(point)
+            {
+                point = 0;
+                if(!pathObjPointList && !pathObjFlagList)
+                {
+                    pathObjPointList = embPointList_create(xx, yy);
+                    startOfPointList = pathObjPointList;
+                    pathObjFlagList = embFlagList_create(svgPathCmdToEmbPathFlag(cmd));
+                    startOfFlagList = pathObjFlagList;
+                }
+                else
+                {
+                    pathObjPointList = embPointList_add(pathObjPointList, embPoint_make(xx, yy));
+                    pathObjFlagList = embFlagList_add(pathObjFlagList, svgPathCmdToEmbPathFlag(cmd));
+                }
+                lx = xx; ly = yy;
+                /* coordinates repeated after a moveto are implicit lineto commands */
+                if(cmd == 'M') cmd = 'L';
+                else if(cmd == 'm') cmd = 'l';
             }
         }
-        free(pathbuff);
-        pathbuff = 0;
 
         /* TODO: subdivide numMoves > 1 */
 
-        embPattern_addPathObjectAbs(p, embPathObject_create(startOfPointList, startOfFlagList, svgColorToEmbColor(svgAttribute_getValue(currentElement, "stroke")), 1));
+        embPattern_addPathObjectAbs(p, embPathObject_create(startOfPointList, startOfFlagList, svgColorToEmbColor(svgAttribute_getValue(reader, SVG_ATTRIBUTE_STROKE)), 1));
     }
-    else if(!strcmp(buff, "polygon") ||
-            !strcmp(buff, "polyline"))
+    else if(reader->element == SVG_ELEMENT_POLYGON ||
+            reader->element == SVG_ELEMENT_POLYLINE)
     {
-        char* pointStr = svgAttribute_getValue(currentElement, "points");
+        const char* pointStr = svgAttribute_getValue(reader, SVG_ATTRIBUTE_POINTS);
         int last = strlen(pointStr);
         int size = 32;
         int i = 0;
@@ -542,12 +448,12 @@ void svgAddToPattern(EmbPattern* p)
                     if(odd)
                     {
                         odd = 0;
-                        xx = atof(polybuff);
+                        xx = emb_strtod(polybuff, 0);
                     }
                     else
                     {
                         odd = 1;
-                        yy = atof(polybuff);
+                        yy = emb_strtod(polybuff, 0);
 
                         if(!polyObjPointList)
                         {
@@ -576,2819 +482,353 @@ void svgAddToPattern(EmbPattern* p)
         free(polybuff);
         polybuff = 0;
 
-        if(!strcmp(buff, "polygon"))
+        if(reader->element == SVG_ELEMENT_POLYGON)
         {
-            EmbPolygonObject* polygonObj = embPolygonObject_create(startOfPointList, svgColorToEmbColor(svgAttribute_getValue(currentElement, "stroke")), 1); /* TODO: use lineType enum */
+            EmbPolygonObject* polygonObj = embPolygonObject_create(startOfPointList, svgColorToEmbColor(svgAttribute_getValue(reader, SVG_ATTRIBUTE_STROKE)), 1); /* TODO: use lineType enum */
             embPattern_addPolygonObjectAbs(p, polygonObj);
         }
         else /* polyline */
         {
-            EmbPolylineObject* polylineObj = embPolylineObject_create(startOfPointList, svgColorToEmbColor(svgAttribute_getValue(currentElement, "stroke")), 1); /* TODO: use lineType enum */
+            EmbPolylineObject* polylineObj = embPolylineObject_create(startOfPointList, svgColorToEmbColor(svgAttribute_getValue(reader, SVG_ATTRIBUTE_STROKE)), 1); /* TODO: use lineType enum */
             embPattern_addPolylineObjectAbs(p, polylineObj);
         }
     }
-    else if(!strcmp(buff, "prefetch"))         {  }
-    else if(!strcmp(buff, "radialGradient"))   {  }
-    else if(!strcmp(buff, "rect"))
+    else if(reader->element == SVG_ELEMENT_RECT)
     {
-        embPattern_addRectObjectAbs(p, atof(svgAttribute_getValue(currentElement, "x")),
-                                       atof(svgAttribute_getValue(currentElement, "y")),
-                                       atof(svgAttribute_getValue(currentElement, "width")),
-                                       atof(svgAttribute_getValue(currentElement, "height")));
+        embPattern_addRectObjectAbs(p, emb_strtod(svgAttribute_getValue(reader, SVG_ATTRIBUTE_X), 0),
+                                       emb_strtod(svgAttribute_getValue(reader, SVG_ATTRIBUTE_Y), 0),
+                                       emb_strtod(svgAttribute_getValue(reader, SVG_ATTRIBUTE_WIDTH), 0),
+                                       emb_strtod(svgAttribute_getValue(reader, SVG_ATTRIBUTE_HEIGHT), 0));
     }
-    else if(!strcmp(buff, "script"))           {  }
-    else if(!strcmp(buff, "set"))              {  }
-    else if(!strcmp(buff, "solidColor"))       {  }
-    else if(!strcmp(buff, "stop"))             {  }
-    else if(!strcmp(buff, "svg"))              {  }
-    else if(!strcmp(buff, "switch"))           {  }
-    else if(!strcmp(buff, "tbreak"))           {  }
-    else if(!strcmp(buff, "text"))             {  }
-    else if(!strcmp(buff, "textArea"))         {  }
-    else if(!strcmp(buff, "title"))            {  }
-    else if(!strcmp(buff, "tspan"))            {  }
-    else if(!strcmp(buff, "use"))              {  }
-    else if(!strcmp(buff, "video"))            {  }
-
-    svgElement_free(currentElement);
-    currentElement = 0;
 }
 
 
-int svgIsElement(const char* buff)
+static int svgIsSpace(char c)
 {
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "?xml"))                { type = SVG_NULL; } /* TODO: Fix the xml version ? messing with svg version */
-    else if(!strcmp(buff, "a"))                   { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "altGlyph"))            { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "altGlyphDef"))         { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "altGlyphItem"))        { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "animate"))             { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "animateColor"))        { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "animateMotion"))       { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "animateTransform"))    { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "animation"))           { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "audio"))               { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "circle"))              { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "clipPath"))            { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "color-profile"))       { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "cursor"))              { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "defs"))                { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "desc"))                { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "discard"))             { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "ellipse"))             { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "feBlend"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feColorMatrix"))       { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feComponentTransfer")) { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feComposite"))         { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feConvolveMatrix"))    { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feDiffuseLighting"))   { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feDisplacementMap"))   { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feDistantLight"))      { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feFlood"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feFuncA"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feFuncB"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feFuncG"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feFuncR"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feGaussianBlur"))      { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feImage"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feMerge"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feMergeNode"))         { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feMorphology"))        { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feOffset"))            { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "fePointLight"))        { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feSpecularLighting"))  { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feSpotLight"))         { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feTile"))              { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feTurbulence"))        { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "filter"))              { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "font"))                { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "font-face"))           { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "font-face-format"))    { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "font-face-name"))      { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "font-face-src"))       { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "font-face-uri"))       { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "foreignObject"))       { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "g"))                   { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "glyph"))               { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "glyphRef"))            { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "handler"))             { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "hkern"))               { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "image"))               { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "line"))                { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "linearGradient"))      { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "listener"))            { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "marker"))              { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "mask"))                { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "metadata"))            { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "missing-glyph"))       { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "mpath"))               { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "path"))                { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "pattern"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "polygon"))             { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "polyline"))            { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "prefetch"))            { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "radialGradient"))      { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "rect"))                { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "script"))              { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "set"))                 { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "solidColor"))          { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "stop"))                { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "style"))               { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "svg"))                 { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "switch"))              { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "symbol"))              { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "tbreak"))              { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "text"))                { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "textArea"))            { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "textPath"))            { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "title"))               { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "tref"))                { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "tspan"))               { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "use"))                 { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "video"))               { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "view"))                { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "vkern"))               { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-
-    /* Attempt to identify the program that created the SVG file. This should be in a comment at that occurs before the svg element. */
-    else if(!strcmp(buff, "Embroidermodder"))     { type = SVG_NULL; svgCreator = SVG_CREATOR_EMBROIDERMODDER; }
-    else if(!strcmp(buff, "Illustrator"))         { type = SVG_NULL; svgCreator = SVG_CREATOR_ILLUSTRATOR; }
-    else if(!strcmp(buff, "Inkscape"))            { type = SVG_NULL; svgCreator = SVG_CREATOR_INKSCAPE; }
-
-    else                                          { type = SVG_NULL; }
-    return type;
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
 }
 
-int svgIsMediaProperty(const char* buff)
+static char* svgSkipSpace(char* p, const char* end)
 {
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "audio-level"))           { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "buffered-rendering"))    { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "display"))               { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "image-rendering"))       { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "pointer-events"))        { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "shape-rendering"))       { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "text-rendering"))        { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "viewport-fill"))         { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "viewport-fill-opacity")) { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "visibility"))            { type = SVG_MEDIA_PROPERTY; }
-    return type;
+    while(p < end && svgIsSpace(*p)) p++;
+    return p;
 }
 
-int svgIsProperty(const char* buff)
+/* Returns the first occurrence of \a marker in [\a p, \a end), or \a end if there is none. */
+static char* svgFind(char* p, const char* end, const char* marker)
 {
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "audio-level"))           { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "buffered-rendering"))    { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "color"))                 { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "color-rendering"))       { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "direction"))             { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "display"))               { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "display-align"))         { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "fill"))                  { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "fill-opacity"))          { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "fill-rule"))             { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "font-family"))           { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "font-size"))             { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "font-style"))            { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "font-variant"))          { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "font-weight"))           { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "image-rendering"))       { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "line-increment"))        { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "opacity"))               { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "pointer-events"))        { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "shape-rendering"))       { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "solid-color"))           { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "solid-opacity"))         { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stop-color"))            { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stop-opacity"))          { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stroke"))                { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stroke-dasharray"))      { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stroke-linecap"))        { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stroke-linejoin"))       { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stroke-miterlimit"))     { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stroke-opacity"))        { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stroke-width"))          { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "text-align"))            { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "text-anchor"))           { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "text-rendering"))        { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "unicode-bidi"))          { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "vector-effect"))         { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "viewport-fill"))         { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "viewport-fill-opacity")) { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "visibility"))            { type = SVG_PROPERTY; }
-    return type;
-}
-
-int svgIsXmlAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "encoding"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "standalone")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "version"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))          { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsXmlAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsLinkAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "target"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsLinkAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsAnimateAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "accumulate"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "additive"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "attributeName"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "attributeType"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "by"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "calcMode"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "dur"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "end"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "fill"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "from"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keySplines"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keyTimes"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "max"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "min"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatCount"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatDur"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "restart"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "to"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "values"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsAnimateAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsAnimateColorAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "accumulate"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "additive"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "attributeName"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "attributeType"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "by"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "calcMode"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "dur"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "end"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "fill"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "from"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keySplines"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keyTimes"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "max"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "min"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatCount"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatDur"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "restart"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "to"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "values"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsAnimateColorAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsAnimateMotionAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "accumulate"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "additive"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "by"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "calcMode"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "dur"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "end"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "fill"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "from"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keyPoints"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keySplines"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keyTimes"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "max"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "min"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "origin"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "path"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatCount"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatDur"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "restart"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rotate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "to"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "values"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsAnimateMotionAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsAnimateTransformAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "accumulate"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "additive"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "attributeName"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "attributeType"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "by"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "calcMode"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "dur"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "end"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "fill"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "from"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keySplines"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keyTimes"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "max"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "min"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatCount"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatDur"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "restart"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "to"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "type"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "values"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsAnimateTransformAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsAnimationAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "dur"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "end"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "fill"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "height"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "initialVisibility"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "max"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "min"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "preserveAspectRatio"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatCount"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatDur"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "restart"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncBehavior"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncMaster"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncTolerance"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "width"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsAnimationAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsAudioAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "dur"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "end"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "fill"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "max"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "min"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatCount"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatDur"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "restart"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncBehavior"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncMaster"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncTolerance"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "type"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsAudioAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsCircleAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "cx"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "cy"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "r"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsCircleAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsDefsAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsDefsAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsDescAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsDescAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsDiscardAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsDiscardAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsEllipseAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "cx"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "cy"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rx"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "ry"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsEllipseAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsFontAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "horiz-adv-x"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "horiz-origin-x"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsFontAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsFontFaceAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "accent-height"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "alphabetic"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "ascent"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "bbox"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "cap-height"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "descent"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "font-family"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "font-stretch"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "font-style"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "font-variant"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "font-weight"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "hanging"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "ideographic"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "mathematical"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "overline-position"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "overline-thickness"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "panose-1"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "slope"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "stemh"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "stemv"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "strikethrough-position"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "strikethrough-thickness"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "underline-position"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "underline-thickness"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "unicode-range"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "units-per-em"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "widths"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x-height"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsFontFaceAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsFontFaceSrcAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsFontFaceSrcAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsFontFaceUriAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsFontFaceUriAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsForeignObjectAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "height"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "width"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsForeignObjectAttribute(), unknown: %s\n", buff); }
-    return type;
+    int length = (int)strlen(marker);
+    for(; p + length <= end; p++)
+    {
+        if(*p == marker[0] && !memcmp(p, marker, length)) return p;
+    }
+    return (char*)end;
 }
 
-int svgIsGroupAttribute(const char* buff)
+/* Replaces the characters the path and points parsers treat as junk with spaces. */
+static void svgCleanValue(char* value)
 {
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsGroupAttribute(), unknown: %s\n", buff); }
-    return type;
+    for(; *value; value++)
+    {
+        if(*value == '"' || *value == '\'' || *value == '/' || *value == ',' || svgIsSpace(*value)) *value = ' ';
+    }
 }
 
-int svgIsGlyphAttribute(const char* buff)
+/* Looks for the name of the program that created the file in the comment [\a p, \a end). */
+static void svgReadComment(SvgReader* reader, char* p, const char* end)
 {
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "arabic-form")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "d"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "glyph-name"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "horiz-adv-x")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "lang"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "unicode"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))           { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsGlyphAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    char* word = 0;
+    int creator;
 
-int svgIsHandlerAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "ev:event"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "type"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsHandlerAttribute(), unknown: %s\n", buff); }
-    return type;
+    while(p < end)
+    {
+        p = svgSkipSpace(p, end);
+        word = p;
+        while(p < end && !svgIsSpace(*p)) p++;
+        creator = svgLookup(word, (int)(p - word), SVG_NAME_CREATOR);
+        if(creator >= 0) reader->creator = creator;
+    }
 }
 
-int svgIsHKernAttribute(const char* buff)
+/* Reads the start tag that follows '<' at \a p, adds it to the pattern if it is
+ * a supported element and returns the position after its closing '>'. */
+static char* svgReadTag(SvgReader* reader, char* p, const char* end)
 {
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "g1"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "g2"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "k"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "u1"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "u2"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsHKernAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    char* name = p;
+    char* value = 0;
+    char quote;
+    int attribute;
 
-int svgIsImageAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "height"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "opacity"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "preserveAspectRatio"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "type"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "width"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsImageAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    while(p < end && !svgIsSpace(*p) && *p != '/' && *p != '>') p++;
+    reader->element = svgLookup(name, (int)(p - name), SVG_NAME_ELEMENT);
+    memset((void*)reader->values, 0, sizeof(reader->values));
 
-int svgIsLineAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x1"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x2"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y1"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y2"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsLineAttribute(), unknown: %s\n", buff); }
-    return type;
+    while(p < end)
+    {
+        p = svgSkipSpace(p, end);
+        if(p >= end) break;
+        if(*p == '>')
+        {
+            if(reader->element >= 0) svgAddToPattern(reader);
+            return p + 1;
+        }
+        if(*p == '/') { p++; continue; }
+
+        name = p;
+        while(p < end && !svgIsSpace(*p) && *p != '=' && *p != '/' && *p != '>') p++;
+        attribute = svgLookup(name, (int)(p - name), SVG_NAME_ATTRIBUTE);
+        p = svgSkipSpace(p, end);
+        if(p >= end || *p != '=') continue;
+        p = svgSkipSpace(p + 1, end);
+        if(p >= end) break;
+        if(*p != '"' && *p != '\'') continue; /* values must be quoted */
+
+        quote = *p;
+        value = p++;
+        while(p < end && *p != quote) p++;
+        if(p >= end) break;
+        if(reader->element >= 0 && attribute >= 0)
+        {
+            /* Shift the value over its opening quote so it can end with a space,
+             * the path and points parsers only take a number when a separator follows it. */
+            memmove(value, value + 1, p - value - 1);
+            p[-1] = ' ';
+            *p = '\0';
+            svgCleanValue(value);
+            reader->values[attribute] = value;
+        }
+        p++;
+    }
+    embLog_error("format-svg.c svgReadTag(), unexpected end of file inside a tag\n");
+    return (char*)end;
 }
 
-int svgIsLinearGradientAttribute(const char* buff)
+/* Reads the whole file into a null terminated buffer allocated from \a context. Returns 0 on failure. */
+static char* svgReadFile(EmbContext* context, const char* fileName, long* size)
 {
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "gradientUnits")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x1"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x2"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y1"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y2"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))             { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsLinearGradientAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    EmbFile* file = 0;
+    char* buffer = 0;
 
-int svgIsListenerAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "defaultAction")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "event"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "handler"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "observer"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "phase"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "propagate"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "target"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))             { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsListenerAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    file = embFile_open(fileName, "rb");
+    if(!file)
+    {
+        embLog_error("format-svg.c readSvg(), cannot open %s for reading\n", fileName);
+        return 0;
+    }
+    embFile_seek(file, 0, SEEK_END);
+    *size = embFile_tell(file);
+    embFile_seek(file, 0, SEEK_SET);
+    if(*size < 0)
+    {
+        embLog_error("format-svg.c readSvg(), cannot determine the size of %s\n", fileName);
+        embFile_close(file);
+        return 0;
+    }
 
-int svgIsMetadataAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsMetadataAttribute(), unknown: %s\n", buff); }
-    return type;
+    buffer = (char*)embContext_allocate(context, *size + 1);
+    if(!buffer)
+    {
+        embLog_error("format-svg.c readSvg(), cannot allocate memory for buffer\n");
+        embFile_close(file);
+        return 0;
+    }
+    *size = (long)embFile_read(buffer, 1, *size, file);
+    buffer[*size] = '\0';
+    embFile_close(file);
+    return buffer;
 }
 
-int svgIsMissingGlyphAttribute(const char* buff)
+/*! Reads a file with the given \a fileName and loads the data into \a pattern.
+ *  Returns \c true if successful, otherwise returns \c false. */
+int readSvg(EmbPattern* pattern, const char* fileName)
 {
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "d"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "horiz-adv-x")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))           { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsMissingGlyphAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    EmbContext* context = embContext_current();
+    SvgReader reader;
+    char* buffer = 0;
+    char* p = 0;
+    char* end = 0;
+    char* close = 0;
+    long size = 0;
 
-int svgIsMPathAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))             { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsMPathAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    if(!pattern) { embLog_error("format-svg.c readSvg(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_error("format-svg.c readSvg(), fileName argument is null\n"); return 0; }
 
-int svgIsPathAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "d"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "pathLength"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsPathAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    buffer = svgReadFile(context, fileName, &size);
+    if(!buffer) return 0;
 
-int svgIsPolygonAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "points"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsPolygonAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    memset(&reader, 0, sizeof(SvgReader));
+    reader.pattern = pattern;
+    reader.creator = SVG_CREATOR_NULL;
 
-int svgIsPolylineAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "points"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsPolylineAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    /* Pre-flip incase of multiple reads on the same pattern */
+    embPattern_flipVertical(pattern);
 
-int svgIsPrefetchAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "bandwidth"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "mediaCharacterEncoding")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "mediaContentEncodings"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "mediaSize"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "mediaTime"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                      { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsPrefetchAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    p = buffer;
+    end = buffer + size;
+    while(p < end)
+    {
+        p = (char*)memchr(p, '<', end - p);
+        if(!p) break;
+        p++;
+        if(end - p >= 3 && !memcmp(p, "!--", 3))
+        {
+            close = svgFind(p + 3, end, "-->");
+            svgReadComment(&reader, p + 3, close);
+            p = close + 3;
+        }
+        else if(end - p >= 8 && !memcmp(p, "![CDATA[", 8))
+        {
+            p = svgFind(p + 8, end, "]]>") + 3;
+        }
+        else if(*p == '?' || *p == '!' || *p == '/') /* declarations and end tags */
+        {
+            close = (char*)memchr(p, '>', end - p);
+            p = close ? close + 1 : end;
+        }
+        else
+        {
+            p = svgReadTag(&reader, p, end);
+        }
+    }
+    embContext_deallocate(context, buffer);
 
-int svgIsRadialGradientAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "cx"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "cy"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "gradientUnits")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "r"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))             { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsRadialGradientAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    /* Flip the pattern since SVG Y+ is down and libembroidery Y+ is up. */
+    embPattern_flipVertical(pattern);
 
-int svgIsRectAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "height"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rx"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "ry"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "width"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsRectAttribute(), unknown: %s\n", buff); }
-    return type;
+    return 1;
 }
 
-int svgIsScriptAttribute(const char* buff)
+/* Writes one "x,y" pair of a points attribute, preceded by a space unless it is the \a first point. */
+static void svgWritePoint(EmbFile* file, double x, double y, int first)
 {
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "type"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsScriptAttribute(), unknown: %s\n", buff); }
-    return type;
+    char buffer[2 * EMB_MAX_NUMBER_LENGTH + 2];
+    int length = 0;
+
+    if(!first) buffer[length++] = ' ';
+    length += emb_formatDouble(buffer + length, x, EMB_MAX_DECIMALS, 1);
+    buffer[length++] = ',';
+    length += emb_formatDouble(buffer + length, y, EMB_MAX_DECIMALS, 1);
+    embFile_write(buffer, 1, length, file);
 }
 
-int svgIsSetAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "attributeName"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "attributeType"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "dur"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "end"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "fill"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "max"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "min"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatCount"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatDur"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "to"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsSetAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+#define SVG_CHUNK_SIZE 4096
 
-int svgIsSolidColorAttribute(const char* buff)
+/* Collects the stitch path data and hands it to the file in SVG_CHUNK_SIZE pieces. */
+typedef struct SvgWriter_
 {
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsSolidColorAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    EmbFile* file;
+    int length;
+    char buffer[SVG_CHUNK_SIZE];
+} SvgWriter;
 
-int svgIsStopAttribute(const char* buff)
+static void svgWriter_flush(SvgWriter* writer)
 {
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "offset"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsStopAttribute(), unknown: %s\n", buff); }
-    return type;
+    if(writer->length > 0) embFile_write(writer->buffer, 1, writer->length, writer->file);
+    writer->length = 0;
 }
 
-int svgIsSvgAttribute(const char* buff)
+static void svgWriter_puts(SvgWriter* writer, const char* str)
 {
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "baseProfile"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "contentScriptType"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "height"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "playbackOrder"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "preserveAspectRatio"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "snapshotTime"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncBehaviorDefault"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncToleranceDefault"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "timelineBegin"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "version"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "viewBox"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "width"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "zoomAndPan"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-    else if(svgCreator == SVG_CREATOR_INKSCAPE)
+    while(*str)
     {
-        if     (!strcmp(buff, "xmlns:dc"))              { type = SVG_ATTRIBUTE; }
-        else if(!strcmp(buff, "xmlns:cc"))              { type = SVG_ATTRIBUTE; }
-        else if(!strcmp(buff, "xmlns:rdf"))             { type = SVG_ATTRIBUTE; }
-        else if(!strcmp(buff, "xmlns:svg"))             { type = SVG_ATTRIBUTE; }
-        else if(!strcmp(buff, "xmlns"))                 { type = SVG_ATTRIBUTE; }
+        if(writer->length == SVG_CHUNK_SIZE) svgWriter_flush(writer);
+        writer->buffer[writer->length++] = *str++;
     }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsSvgAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsSwitchAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsSwitchAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsTBreakAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsTBreakAttribute(), unknown: %s\n", buff); }
-    return type;
 }
 
-int svgIsTextAttribute(const char* buff)
+/* Appends a coordinate given in hundredths of a millimeter using as few characters as SVG path data allows:
+ * no trailing zeroes, no leading zero before the decimal point and no separator in front of a minus sign. */
+static void svgWriter_putCoord(SvgWriter* writer, int value, int separate)
 {
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "editable"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rotate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsTextAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsTextAreaAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "editable"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "height"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "width"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsTextAreaAttribute(), unknown: %s\n", buff); }
-    return type;
-}
-
-int svgIsTitleAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsTitleAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    char digits[16];
+    char* p = digits + sizeof(digits);
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    unsigned int whole = magnitude / 100;
+    unsigned int fraction = magnitude % 100;
 
-int svgIsTSpanAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsTSpanAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    if(writer->length > SVG_CHUNK_SIZE - (int)sizeof(digits)) svgWriter_flush(writer);
 
-int svgIsUseAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsUseAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    if(fraction)
+    {
+        if(fraction % 10) *--p = (char)('0' + fraction % 10);
+        *--p = (char)('0' + fraction / 10);
+        *--p = '.';
+    }
+    if(whole || !fraction)
+    {
+        do { *--p = (char)('0' + whole % 10); whole /= 10; } while(whole);
+    }
+    if(value < 0) *--p = '-';
+    else if(separate) *--p = ' ';
 
-int svgIsVideoAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "dur"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "end"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "fill"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "height"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "initialVisibility"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "max"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "min"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "overlay"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "preserveAspectRatio"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatCount"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatDur"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "restart"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncBehavior"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncMaster"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncTolerance"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transformBehavior"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "type"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "width"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsVideoAttribute(), unknown: %s\n", buff); }
-    return type;
+    memcpy(writer->buffer + writer->length, p, digits + sizeof(digits) - p);
+    writer->length += (int)(digits + sizeof(digits) - p);
 }
 
-
-int svgIsCatchAllAttribute(const char* buff)
+/* Maps a stitch color number to its index in the thread color table the same way embThreadList_getAt() does. */
+static int svgColorIndex(int color, int colorCount)
 {
-    int type = SVG_NULL;
-    /* Catch All Properties */
-    if     (!strcmp(buff, "audio-level"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "buffered-rendering"))        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "color"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "color-rendering"))           { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "direction"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "display"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "display-align"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "fill"))                      { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "fill-opacity"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "fill-rule"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-family"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-size"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-style"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-variant"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-weight"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "image-rendering"))           { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "line-increment"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "opacity"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "pointer-events"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "shape-rendering"))           { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "solid-color"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "solid-opacity"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stop-color"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stop-opacity"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stroke"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stroke-dasharray"))          { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stroke-linecap"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stroke-linejoin"))           { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stroke-miterlimit"))         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stroke-opacity"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stroke-width"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "text-align"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "text-anchor"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "text-rendering"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "unicode-bidi"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "vector-effect"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "viewport-fill"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "viewport-fill-opacity"))     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "visibility"))                { type = SVG_CATCH_ALL; }
-    /* Catch All Attributes */
-    else if(!strcmp(buff, "about"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "accent-height"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "accumulate"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "additive"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "alphabetic"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "arabic-form"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "ascent"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "attributeName"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "attributeType"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "bandwidth"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "baseProfile"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "bbox"))                      { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "begin"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "by"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "calcMode"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "cap-height"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "contentScriptType"))         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "cx"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "cy"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "d"))                         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "defaultAction"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "descent"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "dur"))                       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "editable"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "end"))                       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "ev:event"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "event"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-family"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-stretch"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-style"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-variant"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-weight"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "from"))                      { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "g1"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "g2"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "glyph-name"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "gradientUnits"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "handler"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "hanging"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "height"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "horiz-adv-x"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "horiz-origin-x"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "ideographic"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "initialVisibility"))         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "k"))                         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "keyPoints"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "keySplines"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "keyTimes"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "lang"))                      { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "mathematical"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "max"))                       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "mediaCharacterEncoding"))    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "mediaContentEncodings"))     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "mediaSize"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "mediaTime"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "min"))                       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "observer"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "offset"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "origin"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "overlay"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "overline-position"))         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "overline-thickness"))        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "panose-1"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "path"))                      { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "pathLength"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "phase"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "playbackOrder"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "points"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "preserveAspectRatio"))       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "propagate"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "r"))                         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "repeatCount"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "repeatDur"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "restart"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "rotate"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "rx"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "ry"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "slope"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "snapshotTime"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stemh"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stemv"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "strikethrough-position"))    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "strikethrough-thickness"))   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "syncBehavior"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "syncBehaviorDefault"))       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "syncMaster"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "syncTolerance"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "syncToleranceDefault"))      { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "target"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "timelineBegin"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "to"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "transformBehavior"))         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "type"))                      { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "u1"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "u2"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "underline-position"))        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "underline-thickness"))       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "unicode"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "unicode-range"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "units-per-em"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "values"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "version"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "viewBox"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "width"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "widths"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "x"))                         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "x-height"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "x1"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "x2"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "y"))                         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "y1"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "y2"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "zoomAndPan"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_CATCH_ALL; }
-    return type;
+    if(color < 0 || colorCount == 0) return 0;
+    if(color >= colorCount) return colorCount - 1;
+    return color;
 }
 
-void svgProcess(int c, const char* buff)
+/* Writes every NORMAL run that uses thread \a colorIndex as one path, starting the search at \a stList.
+ * The path data is relative and in hundredths of a millimeter, with the Y axis negated for SVG. */
+static void svgWriteColorPath(SvgWriter* writer, EmbStitchList* stList, int colorIndex, int colorCount, EmbColor color)
 {
-    if(svgExpect == SVG_EXPECT_ELEMENT)
-    {
-        char advance = 0;
-        if(buff[0] == '/') { return; }
+    char header[160];
+    int x = 0, y = 0;
+    int isNormal = 0;
 
-        advance = (char)svgIsElement(buff);
+    /* TODO: use proper thread width for stoke-width rather than just 0.2 */
+    sprintf(header, "\n<path stroke-linejoin=\"round\" stroke-linecap=\"round\" stroke-width=\"0.2\" stroke=\"#%02x%02x%02x\" fill=\"none\" d=\"",
+            color.r, color.g, color.b);
+    svgWriter_puts(writer, header);
 
-        if(advance) { printf("ELEMENT:\n"); svgExpect = SVG_EXPECT_ATTRIBUTE; currentElement = svgElement_create(buff); }
-        else        { return; }
-    }
-    else if(svgExpect == SVG_EXPECT_ATTRIBUTE)
+    while(stList)
     {
-        char advance = 0;
-        const char* name = 0;
-        if(!currentElement) { /* TODO: error */ return; }
-        name = currentElement->name;
-
-        if(!strcmp(name, "?xml"))
-        {
-            if(!advance) { advance = (char)svgIsXmlAttribute(buff); }
-        }
-        else if(!strcmp(name, "a"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsLinkAttribute(buff); }
-        }
-        else if(!strcmp(name, "animate"))
-        {
-            if(!advance) { advance = (char)svgIsAnimateAttribute(buff); }
-        }
-        else if(!strcmp(name, "animateColor"))
-        {
-            if(!advance) { advance = (char)svgIsAnimateColorAttribute(buff); }
-        }
-        else if(!strcmp(name, "animateMotion"))
-        {
-            if(!advance) { advance = (char)svgIsAnimateMotionAttribute(buff); }
-        }
-        else if(!strcmp(name, "animateTransform"))
-        {
-            if(!advance) { advance = (char)svgIsAnimateTransformAttribute(buff); }
-        }
-        else if(!strcmp(name, "animation"))
-        {
-            if(!advance) { advance = (char)svgIsMediaProperty(buff); }
-            if(!advance) { advance = (char)svgIsAnimationAttribute(buff); }
-        }
-        else if(!strcmp(name, "audio"))
-        {
-            if(!advance) { advance = (char)svgIsMediaProperty(buff); }
-            if(!advance) { advance = (char)svgIsAudioAttribute(buff); }
-        }
-        else if(!strcmp(name, "circle"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsCircleAttribute(buff); }
-        }
-        else if(!strcmp(name, "defs"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsDefsAttribute(buff); }
-        }
-        else if(!strcmp(name, "desc"))
-        {
-            if(!advance) { advance = (char)svgIsMediaProperty(buff); }
-            if(!advance) { advance = (char)svgIsDescAttribute(buff); }
-        }
-        else if(!strcmp(name, "discard"))
-        {
-            if(!advance) { advance = (char)svgIsDiscardAttribute(buff); }
-        }
-        else if(!strcmp(name, "ellipse"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsEllipseAttribute(buff); }
-        }
-        else if(!strcmp(name, "font"))
-        {
-            if(!advance) { advance = (char)svgIsFontAttribute(buff); }
-        }
-        else if(!strcmp(name, "font-face"))
-        {
-            if(!advance) { advance = (char)svgIsFontFaceAttribute(buff); }
-        }
-        else if(!strcmp(name, "font-face-src"))
-        {
-            if(!advance) { advance = (char)svgIsFontFaceSrcAttribute(buff); }
-        }
-        else if(!strcmp(name, "font-face-uri"))
-        {
-            if(!advance) { advance = (char)svgIsFontFaceUriAttribute(buff); }
-        }
-        else if(!strcmp(name, "foreignObject"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsForeignObjectAttribute(buff); }
-        }
-        else if(!strcmp(name, "g"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsGroupAttribute(buff); }
-        }
-        else if(!strcmp(name, "glyph"))
-        {
-            if(!advance) { advance = (char)svgIsGlyphAttribute(buff); }
-        }
-        else if(!strcmp(name, "handler"))
-        {
-            if(!advance) { advance = (char)svgIsHandlerAttribute(buff); }
-        }
-        else if(!strcmp(name, "hkern"))
-        {
-            if(!advance) { advance = (char)svgIsHKernAttribute(buff); }
-        }
-        else if(!strcmp(name, "image"))
-        {
-            if(!advance) { advance = (char)svgIsMediaProperty(buff); }
-            if(!advance) { advance = (char)svgIsImageAttribute(buff); }
-        }
-        else if(!strcmp(name, "line"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsLineAttribute(buff); }
-        }
-        else if(!strcmp(name, "linearGradient"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsLinearGradientAttribute(buff); }
-        }
-        else if(!strcmp(name, "listener"))
-        {
-            if(!advance) { advance = (char)svgIsListenerAttribute(buff); }
-        }
-        else if(!strcmp(name, "metadata"))
-        {
-            if(!advance) { advance = (char)svgIsMediaProperty(buff); }
-            if(!advance) { advance = (char)svgIsMetadataAttribute(buff); }
-        }
-        else if(!strcmp(name, "missing-glyph"))
-        {
-            if(!advance) { advance = (char)svgIsMissingGlyphAttribute(buff); }
-        }
-        else if(!strcmp(name, "mpath"))
-        {
-            if(!advance) { advance = (char)svgIsMPathAttribute(buff); }
-        }
-        else if(!strcmp(name, "path"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsPathAttribute(buff); }
-        }
-        else if(!strcmp(name, "polygon"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsPolygonAttribute(buff); }
-        }
-        else if(!strcmp(name, "polyline"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsPolylineAttribute(buff); }
-        }
-        else if(!strcmp(name, "prefetch"))
-        {
-            if(!advance) { advance = (char)svgIsPrefetchAttribute(buff); }
-        }
-        else if(!strcmp(name, "radialGradient"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsRadialGradientAttribute(buff); }
-        }
-        else if(!strcmp(name, "rect"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsRectAttribute(buff); }
-        }
-        else if(!strcmp(name, "script"))
-        {
-            if(!advance) { advance = (char)svgIsScriptAttribute(buff); }
-        }
-        else if(!strcmp(name, "set"))
-        {
-            if(!advance) { advance = (char)svgIsSetAttribute(buff); }
-        }
-        else if(!strcmp(name, "solidColor"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsSolidColorAttribute(buff); }
-        }
-        else if(!strcmp(name, "stop"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsStopAttribute(buff); }
-        }
-        else if(!strcmp(name, "svg"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsSvgAttribute(buff); }
-        }
-        else if(!strcmp(name, "switch"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsSwitchAttribute(buff); }
-        }
-        else if(!strcmp(name, "tbreak"))
+        if(stList->stitch.flags != NORMAL || svgColorIndex(stList->stitch.color, colorCount) != colorIndex)
         {
-            if(!advance) { advance = (char)svgIsTBreakAttribute(buff); }
+            isNormal = 0;
         }
-        else if(!strcmp(name, "text"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsTextAttribute(buff); }
-        }
-        else if(!strcmp(name, "textArea"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsTextAreaAttribute(buff); }
-        }
-        else if(!strcmp(name, "title"))
-        {
-            if(!advance) { advance = (char)svgIsMediaProperty(buff); }
-            if(!advance) { advance = (char)svgIsTitleAttribute(buff); }
-        }
-        else if(!strcmp(name, "tspan"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsTSpanAttribute(buff); }
-        }
-        else if(!strcmp(name, "use"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsUseAttribute(buff); }
-        }
-        else if(!strcmp(name, "video"))
-        {
-            if(!advance) { advance = (char)svgIsMediaProperty(buff); }
-            if(!advance) { advance = (char)svgIsVideoAttribute(buff); }
-        }
-
-        if(advance)
-        {
-            printf("ATTRIBUTE:\n");
-            svgExpect = SVG_EXPECT_VALUE;
-            free(currentAttribute);
-            currentAttribute = 0;
-            currentAttribute = emb_strdup(buff);
-        }
-    }
-    else if(svgExpect == SVG_EXPECT_VALUE)
-    {
-        int last = strlen(buff) - 1;
-        printf("VALUE:\n");
-
-        /* single-value */
-        if((buff[0] == '"' || buff[0] == '\'') && (buff[last] == '/' || buff[last] == '"' || buff[last] == '\'') && !svgMultiValue)
-        {
-            svgExpect = SVG_EXPECT_ATTRIBUTE;
-            svgElement_addAttribute(currentElement, svgAttribute_create(currentAttribute, buff));
-        }
-        else /* multi-value */
+        else
         {
-            svgMultiValue = 1;
-            if(!currentValue)
+            int nx = roundDouble(stList->stitch.xx * 100.0);
+            int ny = roundDouble(-stList->stitch.yy * 100.0);
+            if(!isNormal)
             {
-                currentValue = emb_strdup(buff);
-                if(!currentValue) { /*TODO: error */ return; }
+                /* A lone stitch draws nothing, so it does not need a move */
+                EmbStitchList* next = stList->next;
+                if(next && next->stitch.flags == NORMAL && svgColorIndex(next->stitch.color, colorCount) == colorIndex)
+                {
+                    /* Pairs following a relative move are implicit relative line segments, which readSvg() applies as
+                     * the SVG spec requires, and the first move of a path is absolute. */
+                    isNormal = 1;
+                    svgWriter_puts(writer, "m");
+                    svgWriter_putCoord(writer, nx - x, 0);
+                    svgWriter_putCoord(writer, ny - y, 1);
+                }
             }
             else
             {
-                char* tmp = 0;
-                tmp = emb_strdup(currentValue);
-                free(currentValue);
-                currentValue = 0;
-                currentValue = (char*)malloc(strlen(buff) + strlen(tmp) + 2);
-                if(!currentValue) { embLog_error("format-svg.c svgProcess(), cannot allocate memory for currentValue\n"); return; }
-                if(currentValue) memset(currentValue, 0, strlen(buff) + strlen(tmp) + 2);
-                strcat(currentValue, tmp);
-                strcat(currentValue, " ");
-                strcat(currentValue, buff);
-                free(tmp);
-                tmp = 0;
-            }
-
-            if(buff[last] == '/' || buff[last] == '"' || buff[last] == '\'')
-            {
-                svgMultiValue = 0;
-                svgExpect = SVG_EXPECT_ATTRIBUTE;
-                svgElement_addAttribute(currentElement, svgAttribute_create(currentAttribute, currentValue));
-                free(currentValue);
-                currentValue = 0;
-            }
-        }
-    }
-
-    if(svgExpect != SVG_EXPECT_NULL)
-        printf("%s\n", buff);
-
-    if(c == '>')
-        svgExpect = SVG_EXPECT_NULL;
-}
-
-/*! Reads a file with the given \a fileName and loads the data into \a pattern.
- *  Returns \c true if successful, otherwise returns \c false. */
-int readSvg(EmbPattern* pattern, const char* fileName)
-{
-    EmbFile* file = 0;
-    int size = 1024;
-    int pos;
-    int c = 0;
-    EmbRectObjectList* rList = 0;
-    EmbCircleObjectList* cList = 0;
-    EmbEllipseObjectList* eList = 0;
-    EmbLineObjectList* liList = 0;
-    EmbPointObjectList* poList = 0;
-    EmbPolygonObjectList* pogList = 0;
-    EmbPolylineObjectList* polList = 0;
-    char* buff = 0;
-
-    if(!pattern) { embLog_error("format-svg.c readSvg(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-svg.c readSvg(), fileName argument is null\n"); return 0; }
-
-    buff = (char*)malloc(size);
-    if(!buff) { embLog_error("format-svg.c readSvg(), cannot allocate memory for buff\n"); return 0; }
-
-    svgCreator = SVG_CREATOR_NULL;
-
-    svgExpect = SVG_EXPECT_NULL;
-    svgMultiValue = 0;
-
-    currentElement = 0;
-    currentAttribute = 0;
-    currentValue = 0;
-
-    /* Pre-flip incase of multiple reads on the same pattern */
-    embPattern_flipVertical(pattern);
-
-    file = embFile_open(fileName, "r");
-    if(file)
-    {
-        pos = 0;
-        do
-        {
-            c = embFile_getc(file);
-            switch(c)
-            {
-                case '<':
-                    if(svgExpect == SVG_EXPECT_NULL)
-                    {
-                        svgAddToPattern(pattern);
-                        svgExpect = SVG_EXPECT_ELEMENT;
-                    }
-                case '>':
-                    if(pos == 0) /* abnormal case that may occur in svg element where '>' is all by itself */
-                    {
-                        /*TODO: log a warning about this absurdity! */
-                        svgExpect = SVG_EXPECT_ELEMENT;
-                        break;
-                    }
-                case ' ':
-                case '\t':
-                case '\r':
-                case '\n':
-                case '=':
-                    if(pos == 0)
-                        break;
-                    buff[pos] = 0;
-                    pos = 0;
-                    svgProcess(c, buff);
-                    break;
-                default:
-                    buff[pos++] = (char)c;
-                    break;
-            }
-            if(pos >= size - 1)
-            {
-                /* increase buff length - leave room for 0 */
-                size *= 2;
-                buff = (char*)realloc(buff, size);
-                if(!buff) { embLog_error("format-svg.c readSvg(), cannot re-allocate memory for buff\n"); return 0; }
+                svgWriter_putCoord(writer, nx - x, 1);
+                svgWriter_putCoord(writer, ny - y, 1);
             }
+            if(isNormal) { x = nx; y = ny; }
         }
-        while(c != EOF);
-        embFile_close(file);
-    }
-    free(buff);
-    buff = 0;
-    free(currentAttribute);
-    currentAttribute = 0;
-    free(currentValue);
-    currentValue = 0;
-
-    /*TODO: remove this summary after testing is complete */
-    printf("OBJECT SUMMARY:\n");
-    cList = pattern->circleObjList;
-    while(cList)
-    {
-        EmbCircle c = cList->circleObj.circle;
-        printf("circle %f %f %f\n", c.centerX, c.centerY, c.radius);
-        cList = cList->next;
-    }
-    eList = pattern->ellipseObjList;
-    while(eList)
-    {
-        EmbEllipse e = eList->ellipseObj.ellipse;
-        printf("ellipse %f %f %f %f\n", embEllipse_centerX(e), embEllipse_centerY(e), embEllipse_radiusX(e), embEllipse_radiusY(e));
-        eList = eList->next;
-    }
-    liList = pattern->lineObjList;
-    while(liList)
-    {
-        EmbLine li = liList->lineObj.line;
-        printf("line %f %f %f %f\n", embLine_x1(li), embLine_y1(li), embLine_x2(li), embLine_y2(li));
-        liList = liList->next;
-    }
-    poList = pattern->pointObjList;
-    while(poList)
-    {
-        EmbPoint po = poList->pointObj.point;
-        printf("point %f %f\n", embPoint_x(po), embPoint_y(po));
-        poList = poList->next;
-    }
-    pogList = pattern->polygonObjList;
-    while(pogList)
-    {
-        int vertices = embPointList_count(pogList->polygonObj->pointList);
-        printf("polygon %d\n", vertices);
-        pogList = pogList->next;
-    }
-    polList = pattern->polylineObjList;
-    while(polList)
-    {
-        int vertices = embPointList_count(polList->polylineObj->pointList);
-        printf("polyline %d\n", vertices);
-        polList = polList->next;
+        stList = stList->next;
     }
-    rList = pattern->rectObjList;
-    while(rList)
-    {
-        EmbRect r = rList->rectObj.rect;
-        printf("rect %f %f %f %f\n", embRect_x(r), embRect_y(r), embRect_width(r), embRect_height(r));
-        rList = rList->next;
-    }
-
-    /* Flip the pattern since SVG Y+ is down and libembroidery Y+ is up. */
-    embPattern_flipVertical(pattern);
-
-    return 1; /*TODO: finish readSvg */
+    svgWriter_puts(writer, "\"/>");
 }
 
 /*! Writes the data from \a pattern to a file with the given \a fileName.
+ *  Stitches are written as one relative path per thread color so the file stays small for previews.
+ *  The pattern is not modified.
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeSvg(EmbPattern* pattern, const char* fileName)
 {
     EmbFile* file = 0;
-    EmbRect boundingRect;
     EmbStitchList* stList;
     EmbCircleObjectList* cObjList = 0;
     EmbCircle circle;
@@ -3406,9 +846,6 @@ int writeSvg(EmbPattern* pattern, const char* fileName)
     EmbRect rect;
     EmbColor color;
 
-    char tmpX[32];
-    char tmpY[32];
-
     if(!pattern) { embLog_error("format-svg.c writeSvg(), pattern argument is null\n"); return 0; }
     if(!fileName) { embLog_error("format-svg.c writeSvg(), fileName argument is null\n"); return 0; }
 
@@ -3419,10 +856,8 @@ int writeSvg(EmbPattern* pattern, const char* fileName)
         return 0;
     }
 
-    /* Pre-flip the pattern since SVG Y+ is down and libembroidery Y+ is up. */
-    embPattern_flipVertical(pattern);
+    /* SVG Y+ is down and libembroidery Y+ is up, so every Y value is negated as it is written. */
 
-    boundingRect = embPattern_calcBoundingBox(pattern);
     embFile_printf(file, "<?xml version=\"1.0\"?>\n");
     embFile_printf(file, "<!-- Embroidermodder 2 SVG Embroidery File -->\n");
     embFile_printf(file, "<!-- http://embroidermodder.github.io -->\n");
@@ -3431,20 +866,15 @@ int writeSvg(EmbPattern* pattern, const char* fileName)
     /* TODO: See the SVG Tiny Version 1.2 Specification Section 7.14.
     *       Until all of the formats and API is stable, the width, height and viewBox attributes need to be left unspecified.
     *       If the attribute values are incorrect, some applications wont open it at all.
+    boundingRect = embPattern_calcBoundingBox(pattern);
     embFile_printf(file, "viewBox=\"%f %f %f %f\" ",
             boundingRect.left,
-            boundingRect.top,
+            -boundingRect.bottom,
             embRect_width(boundingRect),
             embRect_height(boundingRect)); */
 
     embFile_printf(file, "xmlns=\"http://www.w3.org/2000/svg\" version=\"1.2\" baseProfile=\"tiny\">");
 
-    /*TODO: Low Priority Optimization:
-    *      Using %g in embFile_printf just doesn't work good enough at trimming trailing zeroes.
-    *      It's precision refers to significant digits, not decimal places (which is what we want).
-    *      We need to roll our own function for trimming trailing zeroes to keep
-    *      the precision as high as possible if needed, but help reduce file size also. */
-
     /*TODO: Low Priority Optimization:
     *      Make sure that the line length that is output doesn't exceed 1000 characters. */
 
@@ -3462,7 +892,7 @@ int writeSvg(EmbPattern* pattern, const char* fileName)
                         color.g,
                         color.b,
                         circle.centerX,
-                        circle.centerY,
+                        -circle.centerY,
                         circle.radius);
         cObjList = cObjList->next;
     }
@@ -3479,7 +909,7 @@ int writeSvg(EmbPattern* pattern, const char* fileName)
                         color.g,
                         color.b,
                         ellipse.centerX,
-                        ellipse.centerY,
+                        -ellipse.centerY,
                         ellipse.radiusX,
                         ellipse.radiusY);
         eObjList = eObjList->next;
@@ -3497,9 +927,9 @@ int writeSvg(EmbPattern* pattern, const char* fileName)
                         color.g,
                         color.b,
                         line.x1,
-                        line.y1,
+                        -line.y1,
                         line.x2,
-                        line.y2);
+                        -line.y2);
         liObjList = liObjList->next;
     }
 
@@ -3518,9 +948,9 @@ int writeSvg(EmbPattern* pattern, const char* fileName)
                         color.g,
                         color.b,
                         point.xx,
-                        point.yy,
+                        -point.yy,
                         point.xx,
-                        point.yy);
+                        -point.yy);
         poObjList = poObjList->next;
     }
 
@@ -3533,16 +963,15 @@ int writeSvg(EmbPattern* pattern, const char* fileName)
         {
             color = pogObjList->polygonObj->color;
             /* TODO: use proper thread width for stoke-width rather than just 0.2 */
-            embFile_printf(file, "\n<polygon stroke-linejoin=\"round\" stroke-linecap=\"round\" stroke-width=\"0.2\" stroke=\"#%02x%02x%02x\" fill=\"none\" points=\"%s,%s",
+            embFile_printf(file, "\n<polygon stroke-linejoin=\"round\" stroke-linecap=\"round\" stroke-width=\"0.2\" stroke=\"#%02x%02x%02x\" fill=\"none\" points=\"",
                     color.r,
                     color.g,
-                    color.b,
-                    emb_optOut(pogPointList->point.xx, tmpX),
-                    emb_optOut(pogPointList->point.yy, tmpY));
+                    color.b);
+            svgWritePoint(file, pogPointList->point.xx, -pogPointList->point.yy, 1);
             pogPointList = pogPointList->next;
             while(pogPointList)
             {
-                embFile_printf(file, " %s,%s", emb_optOut(pogPointList->point.xx, tmpX), emb_optOut(pogPointList->point.yy, tmpY));
+                svgWritePoint(file, pogPointList->point.xx, -pogPointList->point.yy, 0);
                 pogPointList = pogPointList->next;
             }
             embFile_printf(file, "\"/>");
@@ -3559,16 +988,15 @@ int writeSvg(EmbPattern* pattern, const char* fileName)
         {
             color = polObjList->polylineObj->color;
             /* TODO: use proper thread width for stoke-width rather than just 0.2 */
-            embFile_printf(file, "\n<polyline stroke-linejoin=\"round\" stroke-linecap=\"round\" stroke-width=\"0.2\" stroke=\"#%02x%02x%02x\" fill=\"none\" points=\"%s,%s",
+            embFile_printf(file, "\n<polyline stroke-linejoin=\"round\" stroke-linecap=\"round\" stroke-width=\"0.2\" stroke=\"#%02x%02x%02x\" fill=\"none\" points=\"",
                     color.r,
                     color.g,
-                    color.b,
-                    emb_optOut(polPointList->point.xx, tmpX),
-                    emb_optOut(polPointList->point.yy, tmpY));
+                    color.b);
+            svgWritePoint(file, polPointList->point.xx, -polPointList->point.yy, 1);
             polPointList = polPointList->next;
             while(polPointList)
             {
-                embFile_printf(file, " %s,%s", emb_optOut(polPointList->point.xx, tmpX), emb_optOut(polPointList->point.yy, tmpY));
+                svgWritePoint(file, polPointList->point.xx, -polPointList->point.yy, 0);
                 polPointList = polPointList->next;
             }
             embFile_printf(file, "\"/>");
@@ -3588,9 +1016,9 @@ int writeSvg(EmbPattern* pattern, const char* fileName)
                         color.g,
                         color.b,
                         embRect_x(rect),
-                        embRect_y(rect),
+                        -rect.top,
                         embRect_width(rect),
-                        embRect_height(rect));
+                        rect.top - rect.bottom);
         rObjList = rObjList->next;
     }
 
@@ -3598,40 +1026,60 @@ int writeSvg(EmbPattern* pattern, const char* fileName)
     if(stList)
     {
         /*TODO: #ifdef SVG_DEBUG for Josh which outputs JUMPS/TRIMS instead of chopping them out */
-        char isNormal = 0;
+        EmbContext* context = embContext_current();
+        SvgWriter* writer = 0;
+        EmbColor* colors = 0;
+        char* written = 0;
+        int colorCount = embThreadList_count(pattern->threadList);
+        int colorIndex;
+
+        writer = (SvgWriter*)embContext_allocate(context, sizeof(SvgWriter));
+        colors = (EmbColor*)embContext_allocate(context, sizeof(EmbColor) * (colorCount + 1));
+        written = (char*)embContext_allocate(context, colorCount + 1);
+        if(!writer || !colors || !written)
+        {
+            embLog_error("format-svg.c writeSvg(), cannot allocate memory for the stitch paths\n");
+            embContext_deallocate(context, writer);
+            embContext_deallocate(context, colors);
+            embContext_deallocate(context, written);
+            embFile_close(file);
+            return 0;
+        }
+        memset(written, 0, colorCount + 1);
+        writer->file = file;
+        writer->length = 0;
+
+        /* Look each thread up once instead of walking the thread list for every run */
+        colors[0] = embColor_make(0, 0, 0);
+        {
+            EmbThreadList* thread = pattern->threadList;
+            for(colorIndex = 0; thread; colorIndex++, thread = thread->next)
+                colors[colorIndex] = thread->thread.color;
+        }
+
+        /* Each color gets a single path, written in the order the colors first appear */
         while(stList)
         {
-            if(stList->stitch.flags == NORMAL && !isNormal)
-            {
-                    isNormal = 1;
-                    color = embThreadList_getAt(pattern->threadList, stList->stitch.color).color;
-                    /* TODO: use proper thread width for stoke-width rather than just 0.2 */
-                    embFile_printf(file, "\n<polyline stroke-linejoin=\"round\" stroke-linecap=\"round\" stroke-width=\"0.2\" stroke=\"#%02x%02x%02x\" fill=\"none\" points=\"%s,%s",
-                                color.r,
-                                color.g,
-                                color.b,
-                                emb_optOut(stList->stitch.xx, tmpX),
-                                emb_optOut(stList->stitch.yy, tmpY));
-            }
-            else if(stList->stitch.flags == NORMAL && isNormal)
+            if(stList->stitch.flags == NORMAL)
             {
-                embFile_printf(file, " %s,%s", emb_optOut(stList->stitch.xx, tmpX), emb_optOut(stList->stitch.yy, tmpY));
+                colorIndex = svgColorIndex(stList->stitch.color, colorCount);
+                if(!written[colorIndex])
+                {
+                    written[colorIndex] = 1;
+                    svgWriteColorPath(writer, stList, colorIndex, colorCount, colors[colorIndex]);
+                }
             }
-            else if(stList->stitch.flags != NORMAL && isNormal)
-            {
-                isNormal = 0;
-                embFile_printf(file, "\"/>");
-            }
-
             stList = stList->next;
         }
+        svgWriter_flush(writer);
+
+        embContext_deallocate(context, writer);
+        embContext_deallocate(context, colors);
+        embContext_deallocate(context, written);
     }
     embFile_printf(file, "\n</svg>\n");
     embFile_close(file);
 
-    /* Reset the pattern so future writes(regardless of format) are not flipped */
-    embPattern_flipVertical(pattern);
-
     return 1;
 }
 
@@ -2,6 +2,7 @@
 #include "emb-file.h"
 #include "emb-logging.h"
 #include "helpers-misc.h"
+#include <stdio.h>
 
 /*! Reads a file with the given \a fileName and loads the data into \a pattern.
  *  Returns \c true if successful, otherwise returns \c false. */
@@ -18,6 +19,8 @@ int writeTxt(EmbPattern* pattern, const char* fileName)
 {
     EmbStitchList* pointer = 0;
     EmbFile* file = 0;
+    char buffer[2 * EMB_MAX_NUMBER_LENGTH + 48];
+    int length = 0;
 
     if(!pattern) { embLog_error("format-txt.c writeTxt(), pattern argument is null\n"); return 0; }
     if(!fileName) { embLog_error("format-txt.c writeTxt(), fileName argument is null\n"); return 0; }
@@ -44,7 +47,11 @@ int writeTxt(EmbPattern* pattern, const char* fileName)
     while(pointer)
     {
         EmbStitch s = pointer->stitch;
-        embFile_printf(file, "%.1f,%.1f color:%i flags:%i\n", s.xx, s.yy, s.color, s.flags);
+        length = emb_formatDouble(buffer, s.xx, 1, 0);
+        buffer[length++] = ',';
+        length += emb_formatDouble(buffer + length, s.yy, 1, 0);
+        length += sprintf(buffer + length, " color:%i flags:%i\n", s.color, s.flags);
+        embFile_write(buffer, 1, length, file);
         pointer = pointer->next;
     }
 
@@ -278,7 +278,7 @@ void vp3PatchByteCount(EmbFile* file, int offset, int adjustment)
 {
   int currentPos = embFile_tell(file);
   embFile_seek(file, offset, SEEK_SET);
-  embLog_print("Patching byte count: %d\n", currentPos - offset + adjustment);
+  embLog_debug("format-vp3.c vp3PatchByteCount(), patching byte count: %d\n", currentPos - offset + adjustment);
   binaryWriteIntBE(file, currentPos - offset + adjustment);
   embFile_seek(file, currentPos, SEEK_SET);
 }
@@ -430,7 +430,7 @@ int writeVp3(EmbPattern* pattern, const char* fileName)
 		}
 
         s = pointer->stitch;
-        embLog_print("format-vp3.c DEBUG %d, %lf, %lf\n", s.flags, s.xx, s.yy);
+        embLog_debug("format-vp3.c writeVp3(), stitch %d, %lf, %lf\n", s.flags, s.xx, s.yy);
         binaryWriteIntBE(file, s.xx * 1000);
         binaryWriteIntBE(file, -s.yy * 1000);
         pointer = pointer->next;
@@ -444,7 +444,7 @@ int writeVp3(EmbPattern* pattern, const char* fileName)
         binaryWriteByte(file, 1);
         binaryWriteByte(file, 0);
 
-        embLog_print("format-vp3.c writeVp3(), switching to color (%d, %d, %d)\n", color.r, color.g, color.b);
+        embLog_debug("format-vp3.c writeVp3(), switching to color (%d, %d, %d)\n", color.r, color.g, color.b);
         binaryWriteByte(file, color.r);
         binaryWriteByte(file, color.g);
         binaryWriteByte(file, color.b);
@@ -1,7 +1,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <float.h>
 #include <string.h>
+#include <ctype.h>
+#include <locale.h>
 #include "helpers-misc.h"
 #include "emb-logging.h"
 
@@ -105,18 +108,240 @@ void inplace_trim(char* s)
     s[newLength] = '\0';
 }
 
+/* Rounds \a frac * \a power to the nearest integer, where \a frac is the fraction of \a whole + \a frac
+ * and \a power is a power of ten up to 1e10. The product is rounded once from its exact value and
+ * halfway cases go to the even last digit, which is that of \a whole if \a power is 1, so the digits
+ * are the same as those printed by sprintf("%.*f"). */
+static double emb_roundScaled(double whole, double frac, double power)
+{
+    double scaled = frac * power;
+    double rounded = floor(scaled);
+    double remainder = scaled - rounded; /* exact */
+    double mantissa, high, low, a, b, error;
+    int exponent;
+
+    /* The multiply is off by at most half an ulp, so only a remainder this close to .5 can round either way. */
+    if(fabs(remainder - 0.5) > scaled * DBL_EPSILON)
+    {
+        return remainder > 0.5 ? rounded + 1.0 : rounded;
+    }
+
+    /* Split the mantissa in two halves whose products with power are exact,
+     * then recover the rounding error of their sum, so scaled + error is the exact product. */
+    mantissa = frexp(frac, &exponent);
+    high = floor(mantissa * 134217728.0) / 134217728.0;
+    low = mantissa - high;
+    a = ldexp(high * power, exponent);
+    b = ldexp(low * power, exponent);
+    scaled = a + b;
+    error = b - (scaled - a);
+
+    rounded = floor(scaled);
+    remainder = scaled - rounded - 0.5; /* exact, the remainder is close to .5 */
+    if(remainder > -error || (remainder == -error && fmod(power > 1.0 ? rounded : whole, 2.0) != 0.0))
+    {
+        rounded += 1.0;
+    }
+    return rounded;
+}
+
+/*! Writes \a num to \a str with \a decimals digits after the decimal point (0 to EMB_MAX_DECIMALS),
+ *  like sprintf("%.*f") but without parsing a format string or consulting the locale.
+ *  The exact value of \a num is rounded and halfway cases go to the even digit, as in glibc.
+ *  If \a trim is true, trailing zeroes and a trailing decimal point are removed.
+ *  \a str must hold at least EMB_MAX_NUMBER_LENGTH characters.
+ *  Returns the length of the string written to \a str. */
+int emb_formatDouble(char* str, double num, int decimals, int trim)
+{
+    static const double powers[EMB_MAX_DECIMALS + 1] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10 };
+    char digits[16];
+    double scaled, whole;
+    unsigned long intPart;
+    int length = 0, count = 0, i;
+
+    if(decimals < 0) decimals = 0;
+    if(decimals > EMB_MAX_DECIMALS) decimals = EMB_MAX_DECIMALS;
+
+    /* The fast path needs the integer part to fit in 32 bits, anything else (including NaN and infinity) goes through sprintf. */
+    if(!(fabs(num) < 4.0e6))
+    {
+        if(fabs(num) < 1.0e40) length = sprintf(str, "%.*f", decimals, num);
+        else                   length = sprintf(str, "%.17g", num);
+        if(trim && decimals > 0 && strchr(str, '.'))
+        {
+            rTrim(str, '0');
+            rTrim(str, '.');
+            length = (int)strlen(str);
+        }
+        return length;
+    }
+
+    /* Split before scaling so the rounding error of the multiply only affects the fraction. */
+    whole = floor(fabs(num));
+    scaled = emb_roundScaled(whole, fabs(num) - whole, powers[decimals]);
+    if(scaled >= powers[decimals])
+    {
+        whole += 1.0;
+        scaled -= powers[decimals];
+    }
+    intPart = (unsigned long)whole;
+
+    /* The fraction may need more than 32 bits, its digits are taken from the exact integer in scaled. */
+    /* Negative numbers that round to zero and negative zero keep their sign, as in sprintf. */
+    if(num < 0.0 || (num == 0.0 && 1.0 / num < 0.0)) str[length++] = '-';
+    do
+    {
+        digits[count++] = (char)('0' + intPart % 10);
+        intPart /= 10;
+    }
+    while(intPart);
+    while(count) str[length++] = digits[--count];
+
+    if(trim)
+    {
+        while(decimals > 0 && fmod(scaled, 10.0) == 0.0)
+        {
+            scaled = floor(scaled / 10.0);
+            decimals--;
+        }
+    }
+    if(decimals > 0)
+    {
+        str[length++] = '.';
+        for(i = decimals - 1; i >= 0; i--)
+        {
+            str[length + i] = (char)('0' + (int)fmod(scaled, 10.0));
+            scaled = floor(scaled / 10.0);
+        }
+        length += decimals;
+    }
+    str[length] = '\0';
+    return length;
+}
+
 /*! Optimizes the number (\a num) for output to a text file and returns it as a string (\a str). */
 char* emb_optOut(double num, char* str)
 {
-    /* Convert the number to a string */
-    sprintf(str, "%.10f", num);
-    /* Remove trailing zeroes */
-    rTrim(str, '0');
-    /* Remove the decimal point if it happens to be an integer */
-    rTrim(str, '.');
+    emb_formatDouble(str, num, EMB_MAX_DECIMALS, 1);
     return str;
 }
 
+/*! Parses a decimal number at the start of \a str like strtod(), but always
+ *  expects '.' as the decimal point regardless of LC_NUMERIC and does not
+ *  allocate. Leading whitespace is skipped. If \a endPtr is not null it is set
+ *  to the first character after the number, or to \a str if there is none.
+ *  Returns the parsed value, or 0.0 if no number was found. */
+double emb_strtod(const char* str, char** endPtr)
+{
+    /* Every power of ten up to 1e22 is exact in a double, so with at most
+     * 15 significant digits a single multiply or divide is correctly rounded. */
+    static const double powers[23] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    const char* p = str;
+    const char* start = 0;
+    const char* digitsEnd = 0;
+    double mantissa = 0.0;
+    int negative = 0, significant = 0, exponent = 0, exponentValue = 0, exponentNegative = 0;
+    int anyDigits = 0;
+
+    if(!str) { embLog_error("helpers-misc.c emb_strtod(), str argument is null\n"); return 0.0; }
+
+    while(isspace((unsigned char)*p)) p++;
+    start = p;
+    if(*p == '-' || *p == '+')
+    {
+        negative = (*p == '-');
+        p++;
+    }
+
+    while(*p >= '0' && *p <= '9')
+    {
+        anyDigits = 1;
+        if(significant < 15)
+        {
+            if(mantissa > 0.0 || *p != '0') significant++;
+            mantissa = mantissa * 10.0 + (*p - '0');
+        }
+        else
+        {
+            significant++;
+            exponent++;
+        }
+        p++;
+    }
+    if(*p == '.')
+    {
+        p++;
+        while(*p >= '0' && *p <= '9')
+        {
+            anyDigits = 1;
+            if(significant < 15)
+            {
+                if(mantissa > 0.0 || *p != '0') significant++;
+                mantissa = mantissa * 10.0 + (*p - '0');
+                exponent--;
+            }
+            else
+            {
+                significant++;
+            }
+            p++;
+        }
+    }
+    if(!anyDigits)
+    {
+        if(endPtr) *endPtr = (char*)str;
+        return 0.0;
+    }
+    digitsEnd = p;
+
+    if(*p == 'e' || *p == 'E')
+    {
+        const char* e = p + 1;
+        if(*e == '-' || *e == '+')
+        {
+            exponentNegative = (*e == '-');
+            e++;
+        }
+        if(*e >= '0' && *e <= '9')
+        {
+            while(*e >= '0' && *e <= '9')
+            {
+                if(exponentValue < 10000) exponentValue = exponentValue * 10 + (*e - '0');
+                e++;
+            }
+            exponent += exponentNegative ? -exponentValue : exponentValue;
+            p = e;
+        }
+    }
+    if(endPtr) *endPtr = (char*)p;
+
+    if(mantissa == 0.0) return negative ? -0.0 : 0.0;
+    if(significant <= 15 && exponent >= -22 && exponent <= 22)
+    {
+        mantissa = exponent < 0 ? mantissa / powers[-exponent] : mantissa * powers[exponent];
+        return negative ? -mantissa : mantissa;
+    }
+
+    /* Rare slow path for long or extreme numbers: hand a copy of the token to
+     * strtod() with the decimal point the current locale expects. */
+    {
+        char buffer[128];
+        int length = (int)(p - start);
+        int i;
+        char decimalPoint = localeconv()->decimal_point[0];
+
+        if(length >= (int)sizeof(buffer)) length = (int)sizeof(buffer) - 1;
+        memcpy(buffer, start, length);
+        buffer[length] = '\0';
+        for(i = 0; i < length && start + i < digitsEnd; i++)
+        {
+            if(buffer[i] == '.') buffer[i] = decimalPoint;
+        }
+        return strtod(buffer, 0);
+    }
+}
+
 /*! Duplicates the string (\a src) and returns it. It is created on the heap. The caller is responsible for freeing the allocated memory. */
 char* emb_strdup(const char* src)
 {
@@ -8,6 +8,9 @@ extern "C" {
 
 #define PI 3.1415926535
 
+#define EMB_MAX_DECIMALS 10
+#define EMB_MAX_NUMBER_LENGTH 64 /* large enough for any emb_formatDouble() output */
+
 #ifndef MINMAX
 #define MINMAX
   #ifndef max
@@ -25,7 +28,9 @@ char* rTrim(char* const str, char junk);
 char* lTrim(char* const str, char junk);
 char *copy_trim(char const *s);
 void inplace_trim(char *s);
+int emb_formatDouble(char* str, double num, int decimals, int trim);
 char* emb_optOut(double num, char* str);
+double emb_strtod(const char* str, char** endPtr);
 char* emb_strdup(const char* src);
 
 #ifdef __cplusplus
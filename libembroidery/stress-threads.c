@@ -0,0 +1,171 @@
+/* Concurrency stress test for the reentrancy guarantee of emb-context.h
+ *
+ * Every thread writes the same pattern to files of several formats and reads them back, each
+ * call with its own EmbContext, while a single-threaded run of the same conversions gives the
+ * expected results. Build with -fsanitize=thread (CMAKE_C_FLAGS) to have ThreadSanitizer check
+ * the calls for data races. Files are written to the directory given as the only argument, or
+ * to the current directory, and removed afterwards.
+ *
+ * Returns 0 if every conversion gave the expected result without errors. */
+#include "emb-color.h"
+#include "emb-context.h"
+#include "emb-logging.h"
+#include "emb-pattern.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STRESS_THREADS    8
+#define STRESS_ITERATIONS 25
+
+static const char* const stressFormats[] =
+{
+    ".csv", ".dst", ".exp", ".hus", ".jef", ".pec", ".pes", ".svg"
+};
+#define STRESS_FORMAT_COUNT ((int)(sizeof(stressFormats) / sizeof(stressFormats[0])))
+
+/* What a file reads back as, compared between the threads and the reference run */
+typedef struct StressResult_
+{
+    int stitches;
+    int threads;
+    int paths;
+} StressResult;
+
+typedef struct StressThread_
+{
+    pthread_t thread;
+    int index;
+    int failures;
+} StressThread;
+
+static const char* stressDirectory = ".";
+static StressResult stressExpected[STRESS_FORMAT_COUNT];
+
+/* Three colors of zigzag rows with jumps between them */
+static EmbPattern* stress_makePattern(void)
+{
+    EmbPattern* pattern = embPattern_create();
+    EmbThread thread;
+    int color, i;
+
+    if(!pattern) return 0;
+    for(color = 0; color < 3; color++)
+    {
+        thread.color = embColor_make((unsigned char)(80 * color), 200, (unsigned char)(255 - 80 * color));
+        thread.description = "stress";
+        thread.catalogNumber = "";
+        embPattern_addThread(pattern, thread);
+    }
+    for(color = 0; color < 3; color++)
+    {
+        if(color > 0)
+        {
+            embPattern_addStitchRel(pattern, 0.0, 0.0, STOP, 1);
+        }
+        embPattern_addStitchAbs(pattern, 0.0, 10.0 * color, JUMP, 1);
+        for(i = 0; i < 200; i++)
+        {
+            embPattern_addStitchRel(pattern, 0.4, (i % 2) ? -3.0 : 3.0, NORMAL, 1);
+        }
+    }
+    embPattern_addStitchRel(pattern, 0.0, 0.0, END, 1);
+    return pattern;
+}
+
+/* Writes and reads back one file, returns 0 if any call failed or collected an error */
+static int stress_convert(int threadIndex, int iteration, int format, StressResult* result)
+{
+    char fileName[1024];
+    EmbContext context = embContext_init();
+    EmbPattern* pattern = stress_makePattern();
+    EmbPattern* readBack = embPattern_create();
+    EmbStitchList* stitches = 0;
+    EmbThreadList* threads = 0;
+    EmbPathObjectList* paths = 0;
+    int ok = 0;
+
+    context.logLevel = EMB_LOG_NONE; /* errors are still collected */
+    sprintf(fileName, "%.900s/stress-%d-%d%s", stressDirectory, threadIndex, iteration, stressFormats[format]);
+
+    if(pattern && readBack &&
+       embPattern_writeWithContext(&context, pattern, fileName) &&
+       embPattern_readWithContext(&context, readBack, fileName))
+    {
+        memset(result, 0, sizeof(StressResult));
+        for(stitches = readBack->stitchList; stitches; stitches = stitches->next) result->stitches++;
+        for(threads = readBack->threadList; threads; threads = threads->next) result->threads++;
+        for(paths = readBack->pathObjList; paths; paths = paths->next) result->paths++;
+        ok = !context.errorCount;
+    }
+    if(!ok)
+    {
+        fprintf(stderr, "%s: conversion failed\n%s", fileName, embContext_errors(&context));
+    }
+
+    remove(fileName);
+    embContext_clearErrors(&context);
+    if(pattern) embPattern_free(pattern);
+    if(readBack) embPattern_free(readBack);
+    return ok;
+}
+
+static void* stress_run(void* arg)
+{
+    StressThread* thread = (StressThread*)arg;
+    StressResult result;
+    int iteration, format;
+
+    for(iteration = 0; iteration < STRESS_ITERATIONS; iteration++)
+    {
+        /* threads start on different formats so that all of them run at once */
+        for(format = 0; format < STRESS_FORMAT_COUNT; format++)
+        {
+            int f = (format + thread->index) % STRESS_FORMAT_COUNT;
+            if(!stress_convert(thread->index, iteration, f, &result) ||
+               memcmp(&result, &stressExpected[f], sizeof(StressResult)))
+            {
+                fprintf(stderr, "thread %d: %s differs from the single-threaded run\n", thread->index, stressFormats[f]);
+                thread->failures++;
+            }
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    StressThread threads[STRESS_THREADS];
+    int i, failures = 0;
+
+    if(argc > 1) stressDirectory = argv[1];
+
+    for(i = 0; i < STRESS_FORMAT_COUNT; i++)
+    {
+        if(!stress_convert(STRESS_THREADS, 0, i, &stressExpected[i])) return 1;
+    }
+
+    for(i = 0; i < STRESS_THREADS; i++)
+    {
+        threads[i].index = i;
+        threads[i].failures = 0;
+        if(pthread_create(&threads[i].thread, 0, stress_run, &threads[i]))
+        {
+            fprintf(stderr, "cannot start thread %d\n", i);
+            return 1;
+        }
+    }
+    for(i = 0; i < STRESS_THREADS; i++)
+    {
+        pthread_join(threads[i].thread, 0);
+        failures += threads[i].failures;
+    }
+
+    printf("%d conversions on %d threads, %d failed\n",
+           STRESS_THREADS * STRESS_ITERATIONS * STRESS_FORMAT_COUNT, STRESS_THREADS, failures);
+    return failures ? 1 : 0;
+}
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
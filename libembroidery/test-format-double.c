@@ -0,0 +1,104 @@
+/* Differential test of emb_formatDouble() against sprintf("%.*f")
+ *
+ * Formats values on decimal grids, whose halfway points are ties or near-ties once they are
+ * rounded to binary, exact binary ties, a few known near-ties and pseudo-random values with
+ * every number of decimals, trimmed and untrimmed, and compares the results to sprintf in the
+ * C locale. Prints the first mismatches.
+ *
+ * Returns 0 if every value was formatted like sprintf. */
+#include "helpers-misc.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_MAX_REPORTS 20
+
+static long testCount = 0;
+static long testFailures = 0;
+
+static void test_compare(double num, int decimals, int trim)
+{
+    char expected[512];
+    char actual[EMB_MAX_NUMBER_LENGTH];
+    int length;
+
+    sprintf(expected, "%.*f", decimals, num);
+    if(trim && decimals > 0)
+    {
+        rTrim(expected, '0');
+        rTrim(expected, '.');
+    }
+    length = emb_formatDouble(actual, num, decimals, trim);
+
+    testCount++;
+    if(strcmp(expected, actual) || length != (int)strlen(actual))
+    {
+        if(testFailures < TEST_MAX_REPORTS)
+        {
+            fprintf(stderr, "%.17g with %d decimals%s: expected \"%s\", got \"%s\"\n",
+                    num, decimals, trim ? " trimmed" : "", expected, actual);
+        }
+        testFailures++;
+    }
+}
+
+static void test_value(double num)
+{
+    int decimals;
+    for(decimals = 0; decimals <= EMB_MAX_DECIMALS; decimals++)
+    {
+        test_compare(num, decimals, 0);
+        test_compare(num, decimals, 1);
+        test_compare(-num, decimals, 0);
+        test_compare(-num, decimals, 1);
+    }
+}
+
+int main(void)
+{
+    static const double nearTies[] =
+    {
+        0.95, 8826.125, 32.5850285, 0.125, 2.5, 0.5, 1.5, 1.005, 2.675, 1.0000000000500000,
+        0.00000000005, 0.0000000000499999, 3999999.5, 3999999.9999999999, 4000000.5, 1e15 + 0.5
+    };
+    double grids[] = { 0.5, 0.05, 0.005, 0.0005, 0.00005, 0.000005 };
+    unsigned long seed = 12345;
+    long k;
+    int i;
+
+    test_value(0.0);
+    for(i = 0; i < (int)(sizeof(nearTies) / sizeof(nearTies[0])); i++)
+    {
+        test_value(nearTies[i]);
+    }
+
+    /* Halfway points of every number of decimals */
+    for(i = 0; i < (int)(sizeof(grids) / sizeof(grids[0])); i++)
+    {
+        for(k = 0; k < 5000; k++)
+        {
+            test_value(k * grids[i]);
+            test_value(12345.0 + k * grids[i]);
+        }
+    }
+
+    /* Exact binary ties */
+    for(k = 0; k < 5000; k++)
+    {
+        test_value(k / 8.0);
+        test_value(k / 1024.0);
+    }
+
+    /* Pseudo-random values in the range of stitch coordinates */
+    for(k = 0; k < 20000; k++)
+    {
+        seed = (seed * 1103515245UL + 12345UL) & 0x7FFFFFFFUL;
+        test_value((double)seed / 2147483648.0 * 2000.0 - 1000.0);
+    }
+
+    printf("%ld values formatted, %ld differ from sprintf\n", testCount, testFailures);
+    return testFailures ? 1 : 0;
+}
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
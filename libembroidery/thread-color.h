@@ -39,6 +39,7 @@ typedef enum
 
 int threadColorNum(unsigned int color, ThreadBrand brand);
 const char* threadColorName(unsigned int color, ThreadBrand brand);
+unsigned int threadColorNearest(unsigned int color, ThreadBrand brand);
 
 #ifdef __cplusplus
 }
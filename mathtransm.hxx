@@ -39,6 +39,7 @@
 #define _MATHTRANSM_HXX 1
 
 #include<cmath>
+#include<cstring>
 #include<mathvector.hxx>
 
 namespace math
@@ -160,7 +161,7 @@ namespace math
      * this * other
      */
     inline transform_matrix<T,DIM>
-    operator*(const transform_matrix<T,DIM>& other)
+    operator*(const transform_matrix<T,DIM>& other) const
     {
       transform_matrix<T,DIM> newm;
 
@@ -197,7 +198,7 @@ namespace math
      * Transform vector
      *  = M * v
      */
-    inline vector<T,DIM> operator*(const vector<T,DIM>& v)
+    inline vector<T,DIM> operator*(const vector<T,DIM>& v) const
     {
       vector<T,DIM> newv;
 
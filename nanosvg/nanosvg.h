@@ -29,6 +29,8 @@
 #ifndef NANOSVG_H
 #define NANOSVG_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -169,6 +171,37 @@ NSVGimage* nsvgParse(char* input, const char* units, float dpi);
 // Deletes list of paths.
 void nsvgDelete(NSVGimage* image);
 
+// Incremental parser, the SVG data is pushed in chunks of any size.
+// Each shape is converted to the units and passed to shapeCb as soon as its element has been parsed.
+// The callback owns the shape and must free it with nsvgDeleteShape().
+// The input is never modified. Only the tag being parsed is copied, so memory use follows the largest
+// element rather than the whole document. Gradients must be defined before they are used, and if the
+// root element has no size nor viewBox, shapes are not moved to the origin of their bounds.
+// If viewCb is not NULL, it is called once the root element has been parsed, with the size of the
+// document in the units. It may change xform (identity on entry) to a transform applied to every
+// shape after the conversion to the units. It is combined with the view and element transforms, so
+// each point is transformed once. Because of that single combined transform, points differ from
+// nsvgParse() by float rounding, in the order of 1e-6 of the document size.
+typedef struct NSVGstream NSVGstream;
+NSVGstream* nsvgCreateStream(const char* units, float dpi,
+							 void (*viewCb)(void* ud, float width, float height, float* xform),
+							 void (*shapeCb)(void* ud, NSVGshape* shape), void* ud);
+
+// Parses a chunk of SVG data. Returns 0 if out of memory.
+int nsvgStreamParse(NSVGstream* stream, const char* data, size_t size);
+
+// Deletes the incremental parser, data after the last complete tag is ignored.
+void nsvgDeleteStream(NSVGstream* stream);
+
+// Parses SVG file from a read-only memory map of the file, or in chunks where mmap is not available,
+// passing each shape to shapeCb as nsvgCreateStream() does. Returns 0 if the file can not be read.
+int nsvgParseFromFileStream(const char* filename, const char* units, float dpi,
+							void (*viewCb)(void* ud, float width, float height, float* xform),
+							void (*shapeCb)(void* ud, NSVGshape* shape), void* ud);
+
+// Deletes a shape passed to the callback of the incremental parser.
+void nsvgDeleteShape(NSVGshape* shape);
+
 #ifdef __cplusplus
 };
 #endif
@@ -177,10 +210,19 @@ void nsvgDelete(NSVGimage* image);
 
 #ifdef NANOSVG_IMPLEMENTATION
 
+#include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+	#define NSVG_USE_MMAP 1
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
 #define NSVG_PI (3.14159265358979323846264338327f)
 #define NSVG_KAPPA90 (0.5522847493f)	// Lenght proportional to radius of a cubic bezier handle for 90deg arcs.
 
@@ -214,16 +256,30 @@ static int nsvg__isspace(char c)
 
 static int nsvg__isdigit(char c)
 {
-	return strchr("0123456789", c) != 0;
+	return c >= '0' && c <= '9';
 }
 
-static int nsvg__isnum(char c)
+static NSVG_INLINE float nsvg__minf(float a, float b) { return a < b ? a : b; }
+static NSVG_INLINE float nsvg__maxf(float a, float b) { return a > b ? a : b; }
+
+// Keyword lookup through perfect hash tables, generated offline for each keyword list.
+// The FNV-1a hash of the string picks a displacement, the displaced hash picks the slot, which holds the
+// keyword index + 1, or 0. Returns the index the string would be, the caller compares the keyword.
+static int nsvg__hashKeyword(const char* s, size_t n, const unsigned char* disp, unsigned int dispMask,
+							 const unsigned char* slots, int slotBits)
 {
-	return strchr("0123456789+-.eE", c) != 0;
+	unsigned int h = 2166136261u;
+	size_t i;
+	for (i = 0; i < n; i++)
+		h = (h ^ (unsigned char)s[i]) * 16777619u;
+	h = (((h ^ disp[h & dispMask]) * 2654435761u) & 0xffffffffu) >> (32 - slotBits);
+	return (int)slots[h] - 1;
 }
 
-static NSVG_INLINE float nsvg__minf(float a, float b) { return a < b ? a : b; }
-static NSVG_INLINE float nsvg__maxf(float a, float b) { return a > b ? a : b; }
+static int nsvg__isKeyword(const char* keyword, const char* s, size_t n)
+{
+	return strncmp(keyword, s, n) == 0 && keyword[n] == '\0';
+}
 
 
 // Simple XML parser
@@ -438,6 +494,13 @@ typedef struct NSVGparser
 	float dpi;
 	char pathFlag;
 	char defsFlag;
+	void (*shapeCb)(void* ud, NSVGshape* shape);	// Incremental parser receiving shapes, or NULL.
+	void (*viewCb)(void* ud, float width, float height, float* xform);
+	void* shapeUd;
+	char units[8];
+	char viewFolded;				// View transform below is part of the root transform.
+	float viewTx, viewTy, viewSx, viewSy;
+	float docXform[6];				// Transform from viewCb, after the view transform.
 } NSVGparser;
 
 static void nsvg__xformIdentity(float* t)
@@ -914,6 +977,8 @@ static void nsvg__getLocalBounds(float* bounds, NSVGshape *shape, float* xform)
 	}
 }
 
+static void nsvg__streamShape(NSVGparser* p, NSVGshape* shape);
+
 static void nsvg__addShape(NSVGparser* p)
 {
 	NSVGattrib* attr = nsvg__getAttr(p);
@@ -992,6 +1057,11 @@ static void nsvg__addShape(NSVGparser* p)
 	// Set flags
 	shape->flags = (attr->visible ? NSVG_FLAGS_VISIBLE : 0x00);
 
+	if (p->shapeCb != NULL) {
+		nsvg__streamShape(p, shape);
+		return;
+	}
+
 	// Add to tail
 	prev = NULL;
 	cur = p->image->shapes;
@@ -1066,65 +1136,71 @@ error:
 	}
 }
 
-static const char* nsvg__parseNumber(const char* s, char* it, const int size)
+// Exact powers of ten, used to scale a parsed mantissa with a single correctly rounded operation.
+static const double nsvg__pow10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Parses the number at s in place and returns the character after it, or s if there is no number.
+// Numbers with at most 15 significant digits and a decimal exponent within +-22 are exact in
+// doubles and converted here with the same result as atof(), others fall back to strtod().
+static const char* nsvg__parseFloat(const char* s, float* val)
 {
-	const int last = size-1;
-	int i = 0;
+	const char* cur = s;
+	const char* expStart;
+	char* end;
+	double mant = 0.0;
+	int neg = 0, ndigits = 0, nsig = 0, inexact = 0, exp = 0, e = 0, eneg = 0;
 
 	// sign
-	if (*s == '-' || *s == '+') {
-		if (i < last) it[i++] = *s;
-		s++;
-	}
+	if (*cur == '-' || *cur == '+')
+		neg = *cur++ == '-';
 	// integer part
-	while (*s && nsvg__isdigit(*s)) {
-		if (i < last) it[i++] = *s;
-		s++;
-	}
-	if (*s == '.') {
-		// decimal point
-		if (i < last) it[i++] = *s;
-		s++;
-		// fraction part
-		while (*s && nsvg__isdigit(*s)) {
-			if (i < last) it[i++] = *s;
-			s++;
+	for (; nsvg__isdigit(*cur); cur++, ndigits++) {
+		if (nsig < 15) {
+			mant = mant*10.0 + (*cur - '0');
+			if (mant > 0.0) nsig++;
+		} else {
+			if (*cur != '0') inexact = 1;
+			exp++;
 		}
 	}
-	// exponent
-	if (*s == 'e' || *s == 'E') {
-		if (i < last) it[i++] = *s;
-		s++;
-		if (*s == '-' || *s == '+') {
-			if (i < last) it[i++] = *s;
-			s++;
+	// fraction part
+	if (*cur == '.') {
+		for (cur++; nsvg__isdigit(*cur); cur++, ndigits++) {
+			if (nsig < 15) {
+				mant = mant*10.0 + (*cur - '0');
+				if (mant > 0.0) nsig++;
+				exp--;
+			} else if (*cur != '0') {
+				inexact = 1;
+			}
 		}
-		while (*s && nsvg__isdigit(*s)) {
-			if (i < last) it[i++] = *s;
-			s++;
+	}
+	if (ndigits == 0)
+		return s;
+	// exponent, only if digits follow
+	if (*cur == 'e' || *cur == 'E') {
+		expStart = cur + 1;
+		if (*expStart == '-' || *expStart == '+')
+			eneg = *expStart++ == '-';
+		if (nsvg__isdigit(*expStart)) {
+			for (cur = expStart; nsvg__isdigit(*cur); cur++)
+				if (e < 10000) e = e*10 + (*cur - '0');
+			exp += eneg ? -e : e;
 		}
 	}
-	it[i] = '\0';
-
-	return s;
-}
 
-static const char* nsvg__getNextPathItem(const char* s, char* it)
-{
-	it[0] = '\0';
-	// Skip white spaces and commas
-	while (*s && (nsvg__isspace(*s) || *s == ',')) s++;
-	if (!*s) return s;
-	if (*s == '-' || *s == '+' || *s == '.' || nsvg__isdigit(*s)) {
-		s = nsvg__parseNumber(s, it, 64);
+	if (mant == 0.0) {
+		*val = neg ? -0.0f : 0.0f;
+	} else if (!inexact && exp >= -22 && exp <= 22) {
+		mant = exp < 0 ? mant / nsvg__pow10[-exp] : mant * nsvg__pow10[exp];
+		*val = (float)(neg ? -mant : mant);
 	} else {
-		// Parse command
-		it[0] = *s++;
-		it[1] = '\0';
-		return s;
+		*val = (float)strtod(s, &end);
 	}
-
-	return s;
+	return cur;
 }
 
 static unsigned int nsvg__parseColorHex(const char* str)
@@ -1319,15 +1395,38 @@ NSVGNamedColor nsvg__colors[] = {
 #endif
 };
 
+// Perfect hash of all the names above, the basic colors come first so that it serves both tables.
+static const unsigned char nsvg__colorHashDisp[32] = {
+	0, 0, 0, 20, 0, 2, 0, 0, 26, 12, 1, 0, 2, 10, 32, 20,
+	0, 6, 14, 12, 2, 40, 0, 3, 28, 39, 0, 15, 2, 5, 10, 7,
+};
+static const unsigned char nsvg__colorHashSlots[256] = {
+	0, 67, 103, 0, 0, 0, 14, 68, 57, 0, 130, 2, 7, 0, 0, 0,
+	83, 60, 0, 0, 0, 53, 0, 58, 0, 76, 0, 0, 0, 0, 0, 139,
+	61, 21, 78, 0, 56, 95, 0, 142, 0, 0, 0, 147, 127, 1, 0, 104,
+	125, 138, 63, 62, 41, 140, 0, 86, 16, 114, 6, 18, 0, 84, 98, 17,
+	0, 141, 0, 96, 136, 85, 106, 3, 0, 132, 145, 0, 0, 29, 49, 88,
+	0, 116, 50, 0, 45, 0, 15, 120, 107, 0, 52, 0, 36, 74, 0, 112,
+	72, 37, 0, 118, 42, 0, 0, 0, 111, 146, 5, 44, 87, 0, 109, 0,
+	30, 110, 0, 0, 144, 19, 0, 0, 122, 0, 70, 22, 0, 0, 81, 119,
+	123, 0, 0, 0, 59, 23, 128, 55, 8, 0, 0, 0, 0, 0, 34, 51,
+	4, 66, 0, 28, 93, 43, 113, 135, 77, 0, 0, 99, 46, 90, 0, 25,
+	0, 12, 0, 0, 0, 80, 48, 0, 0, 0, 0, 0, 0, 0, 134, 0,
+	129, 0, 0, 26, 13, 40, 0, 0, 27, 69, 0, 0, 82, 0, 39, 92,
+	0, 79, 124, 115, 38, 9, 35, 0, 0, 0, 47, 0, 32, 0, 31, 131,
+	33, 0, 0, 117, 121, 100, 0, 0, 133, 0, 0, 0, 0, 0, 126, 0,
+	143, 24, 0, 20, 0, 102, 0, 0, 0, 0, 89, 97, 54, 73, 0, 65,
+	108, 105, 0, 94, 137, 0, 0, 101, 0, 11, 75, 64, 91, 0, 71, 10,
+};
+
 static unsigned int nsvg__parseColorName(const char* str)
 {
-	int i, ncolors = sizeof(nsvg__colors) / sizeof(NSVGNamedColor);
+	int ncolors = sizeof(nsvg__colors) / sizeof(NSVGNamedColor);
+	size_t n = strlen(str);
+	int i = nsvg__hashKeyword(str, n, nsvg__colorHashDisp, 31, nsvg__colorHashSlots, 8);
 
-	for (i = 0; i < ncolors; i++) {
-		if (strcmp(nsvg__colors[i].name, str) == 0) {
-			return nsvg__colors[i].color;
-		}
-	}
+	if (i >= 0 && i < ncolors && nsvg__isKeyword(nsvg__colors[i].name, str, n))
+		return nsvg__colors[i].color;
 
 	return NSVG_RGB(128, 128, 128);
 }
@@ -1401,7 +1500,7 @@ static int nsvg__parseTransformArgs(const char* str, float* args, int maxNa, int
 {
 	const char* end;
 	const char* ptr;
-	char it[64];
+	const char* next;
 
 	*na = 0;
 	ptr = str;
@@ -1416,8 +1515,13 @@ static int nsvg__parseTransformArgs(const char* str, float* args, int maxNa, int
 	while (ptr < end) {
 		if (*ptr == '-' || *ptr == '+' || *ptr == '.' || nsvg__isdigit(*ptr)) {
 			if (*na >= maxNa) return 0;
-			ptr = nsvg__parseNumber(ptr, it, 64);
-			args[(*na)++] = (float)atof(it);
+			next = nsvg__parseFloat(ptr, &args[*na]);
+			if (next == ptr) {
+				++ptr;
+			} else {
+				ptr = next;
+				(*na)++;
+			}
 		} else {
 			++ptr;
 		}
@@ -1630,20 +1734,81 @@ static int nsvg__parseStrokeDashArray(NSVGparser* p, const char* str, float* str
 
 static void nsvg__parseStyle(NSVGparser* p, const char* str);
 
-static int nsvg__parseAttr(NSVGparser* p, const char* name, const char* value)
+enum NSVGattrName {
+	NSVG_ATTR_STYLE = 0,
+	NSVG_ATTR_DISPLAY,
+	NSVG_ATTR_FILL,
+	NSVG_ATTR_OPACITY,
+	NSVG_ATTR_FILL_OPACITY,
+	NSVG_ATTR_STROKE,
+	NSVG_ATTR_STROKE_WIDTH,
+	NSVG_ATTR_STROKE_DASHARRAY,
+	NSVG_ATTR_STROKE_DASHOFFSET,
+	NSVG_ATTR_STROKE_OPACITY,
+	NSVG_ATTR_STROKE_LINECAP,
+	NSVG_ATTR_STROKE_LINEJOIN,
+	NSVG_ATTR_FILL_RULE,
+	NSVG_ATTR_FONT_SIZE,
+	NSVG_ATTR_TRANSFORM,
+	NSVG_ATTR_STOP_COLOR,
+	NSVG_ATTR_STOP_OPACITY,
+	NSVG_ATTR_OFFSET,
+	NSVG_ATTR_ID,
+};
+
+static const char* nsvg__attrNames[] = {
+	"style",
+	"display",
+	"fill",
+	"opacity",
+	"fill-opacity",
+	"stroke",
+	"stroke-width",
+	"stroke-dasharray",
+	"stroke-dashoffset",
+	"stroke-opacity",
+	"stroke-linecap",
+	"stroke-linejoin",
+	"fill-rule",
+	"font-size",
+	"transform",
+	"stop-color",
+	"stop-opacity",
+	"offset",
+	"id",
+};
+
+// Perfect hash of nsvg__attrNames, used for attributes and style properties.
+static const unsigned char nsvg__attrHashDisp[8] = {
+	4, 3, 1, 1, 0, 0, 0, 0,
+};
+static const unsigned char nsvg__attrHashSlots[32] = {
+	7, 4, 18, 2, 5, 0, 0, 0, 17, 1, 13, 16, 0, 0, 0, 0,
+	19, 12, 0, 0, 0, 11, 0, 15, 9, 0, 3, 0, 8, 14, 10, 6,
+};
+
+static int nsvg__attrName(const char* name, size_t n)
+{
+	int i = nsvg__hashKeyword(name, n, nsvg__attrHashDisp, 7, nsvg__attrHashSlots, 5);
+	return (i >= 0 && nsvg__isKeyword(nsvg__attrNames[i], name, n)) ? i : -1;
+}
+
+static int nsvg__parseAttrName(NSVGparser* p, int name, const char* value)
 {
 	float xform[6];
 	NSVGattrib* attr = nsvg__getAttr(p);
 	if (!attr) return 0;
 
-	if (strcmp(name, "style") == 0) {
+	switch (name) {
+	case NSVG_ATTR_STYLE:
 		nsvg__parseStyle(p, value);
-	} else if (strcmp(name, "display") == 0) {
+		break;
+	case NSVG_ATTR_DISPLAY:
 		if (strcmp(value, "none") == 0)
 			attr->visible = 0;
 		// Don't reset ->visible on display:inline, one display:none hides the whole subtree
-
-	} else if (strcmp(name, "fill") == 0) {
+		break;
+	case NSVG_ATTR_FILL:
 		if (strcmp(value, "none") == 0) {
 			attr->hasFill = 0;
 		} else if (strncmp(value, "url(", 4) == 0) {
@@ -1653,11 +1818,14 @@ static int nsvg__parseAttr(NSVGparser* p, const char* name, const char* value)
 			attr->hasFill = 1;
 			attr->fillColor = nsvg__parseColor(value);
 		}
-	} else if (strcmp(name, "opacity") == 0) {
+		break;
+	case NSVG_ATTR_OPACITY:
 		attr->opacity = nsvg__parseOpacity(value);
-	} else if (strcmp(name, "fill-opacity") == 0) {
+		break;
+	case NSVG_ATTR_FILL_OPACITY:
 		attr->fillOpacity = nsvg__parseOpacity(value);
-	} else if (strcmp(name, "stroke") == 0) {
+		break;
+	case NSVG_ATTR_STROKE:
 		if (strcmp(value, "none") == 0) {
 			attr->hasStroke = 0;
 		} else if (strncmp(value, "url(", 4) == 0) {
@@ -1667,46 +1835,65 @@ static int nsvg__parseAttr(NSVGparser* p, const char* name, const char* value)
 			attr->hasStroke = 1;
 			attr->strokeColor = nsvg__parseColor(value);
 		}
-	} else if (strcmp(name, "stroke-width") == 0) {
+		break;
+	case NSVG_ATTR_STROKE_WIDTH:
 		attr->strokeWidth = nsvg__parseCoordinate(p, value, 0.0f, nsvg__actualLength(p));
-	} else if (strcmp(name, "stroke-dasharray") == 0) {
+		break;
+	case NSVG_ATTR_STROKE_DASHARRAY:
 		attr->strokeDashCount = nsvg__parseStrokeDashArray(p, value, attr->strokeDashArray);
-	} else if (strcmp(name, "stroke-dashoffset") == 0) {
+		break;
+	case NSVG_ATTR_STROKE_DASHOFFSET:
 		attr->strokeDashOffset = nsvg__parseCoordinate(p, value, 0.0f, nsvg__actualLength(p));
-	} else if (strcmp(name, "stroke-opacity") == 0) {
+		break;
+	case NSVG_ATTR_STROKE_OPACITY:
 		attr->strokeOpacity = nsvg__parseOpacity(value);
-	} else if (strcmp(name, "stroke-linecap") == 0) {
+		break;
+	case NSVG_ATTR_STROKE_LINECAP:
 		attr->strokeLineCap = nsvg__parseLineCap(value);
-	} else if (strcmp(name, "stroke-linejoin") == 0) {
+		break;
+	case NSVG_ATTR_STROKE_LINEJOIN:
 		attr->strokeLineJoin = nsvg__parseLineJoin(value);
-	} else if (strcmp(name, "fill-rule") == 0) {
+		break;
+	case NSVG_ATTR_FILL_RULE:
 		attr->fillRule = nsvg__parseFillRule(value);
-	} else if (strcmp(name, "font-size") == 0) {
+		break;
+	case NSVG_ATTR_FONT_SIZE:
 		attr->fontSize = nsvg__parseCoordinate(p, value, 0.0f, nsvg__actualLength(p));
-	} else if (strcmp(name, "transform") == 0) {
+		break;
+	case NSVG_ATTR_TRANSFORM:
 		nsvg__parseTransform(xform, value);
 		nsvg__xformPremultiply(attr->xform, xform);
-	} else if (strcmp(name, "stop-color") == 0) {
+		break;
+	case NSVG_ATTR_STOP_COLOR:
 		attr->stopColor = nsvg__parseColor(value);
-	} else if (strcmp(name, "stop-opacity") == 0) {
+		break;
+	case NSVG_ATTR_STOP_OPACITY:
 		attr->stopOpacity = nsvg__parseOpacity(value);
-	} else if (strcmp(name, "offset") == 0) {
+		break;
+	case NSVG_ATTR_OFFSET:
 		attr->stopOffset = nsvg__parseCoordinate(p, value, 0.0f, 1.0f);
-	} else if (strcmp(name, "id") == 0) {
+		break;
+	case NSVG_ATTR_ID:
 		strncpy(attr->id, value, 63);
 		attr->id[63] = '\0';
-	} else {
+		break;
+	default:
 		return 0;
 	}
 	return 1;
 }
 
+static int nsvg__parseAttr(NSVGparser* p, const char* name, const char* value)
+{
+	return nsvg__parseAttrName(p, nsvg__attrName(name, strlen(name)), value);
+}
+
 static int nsvg__parseNameValue(NSVGparser* p, const char* start, const char* end)
 {
 	const char* str;
 	const char* val;
-	char name[512];
 	char value[512];
+	int name;
 	int n;
 
 	str = start;
@@ -1718,10 +1905,12 @@ static int nsvg__parseNameValue(NSVGparser* p, const char* start, const char* en
 	while (str > start &&  (*str == ':' || nsvg__isspace(*str))) --str;
 	++str;
 
+	// Look up the name in place, unknown properties are skipped without copying the value.
 	n = (int)(str - start);
 	if (n > 511) n = 511;
-	if (n) memcpy(name, start, n);
-	name[n] = 0;
+	name = nsvg__attrName(start, n);
+	if (name < 0)
+		return 0;
 
 	while (val < end && (*val == ':' || nsvg__isspace(*val))) ++val;
 
@@ -1730,7 +1919,7 @@ static int nsvg__parseNameValue(NSVGparser* p, const char* start, const char* en
 	if (n) memcpy(value, val, n);
 	value[n] = 0;
 
-	return nsvg__parseAttr(p, name, value);
+	return nsvg__parseAttrName(p, name, value);
 }
 
 static void nsvg__parseStyle(NSVGparser* p, const char* str)
@@ -1758,45 +1947,11 @@ static void nsvg__parseAttribs(NSVGparser* p, const char** attr)
 {
 	int i;
 	for (i = 0; attr[i]; i += 2)
-	{
-		if (strcmp(attr[i], "style") == 0)
-			nsvg__parseStyle(p, attr[i + 1]);
-		else
-			nsvg__parseAttr(p, attr[i], attr[i + 1]);
-	}
-}
-
-static int nsvg__getArgsPerElement(char cmd)
-{
-	switch (cmd) {
-		case 'v':
-		case 'V':
-		case 'h':
-		case 'H':
-			return 1;
-		case 'm':
-		case 'M':
-		case 'l':
-		case 'L':
-		case 't':
-		case 'T':
-			return 2;
-		case 'q':
-		case 'Q':
-		case 's':
-		case 'S':
-			return 4;
-		case 'c':
-		case 'C':
-			return 6;
-		case 'a':
-		case 'A':
-			return 7;
-	}
-	return 0;
+		nsvg__parseAttr(p, attr[i], attr[i + 1]);
 }
 
-static void nsvg__pathMoveTo(NSVGparser* p, float* cpx, float* cpy, float* args, int rel)
+static void nsvg__pathMoveTo(NSVGparser* p, float* cpx, float* cpy,
+							 float* cpx2, float* cpy2, float* args, int rel)
 {
 	if (rel) {
 		*cpx += args[0];
@@ -1806,9 +1961,12 @@ static void nsvg__pathMoveTo(NSVGparser* p, float* cpx, float* cpy, float* args,
 		*cpy = args[1];
 	}
 	nsvg__moveTo(p, *cpx, *cpy);
+	*cpx2 = *cpx;
+	*cpy2 = *cpy;
 }
 
-static void nsvg__pathLineTo(NSVGparser* p, float* cpx, float* cpy, float* args, int rel)
+static void nsvg__pathLineTo(NSVGparser* p, float* cpx, float* cpy,
+							 float* cpx2, float* cpy2, float* args, int rel)
 {
 	if (rel) {
 		*cpx += args[0];
@@ -1818,24 +1976,32 @@ static void nsvg__pathLineTo(NSVGparser* p, float* cpx, float* cpy, float* args,
 		*cpy = args[1];
 	}
 	nsvg__lineTo(p, *cpx, *cpy);
+	*cpx2 = *cpx;
+	*cpy2 = *cpy;
 }
 
-static void nsvg__pathHLineTo(NSVGparser* p, float* cpx, float* cpy, float* args, int rel)
+static void nsvg__pathHLineTo(NSVGparser* p, float* cpx, float* cpy,
+							  float* cpx2, float* cpy2, float* args, int rel)
 {
 	if (rel)
 		*cpx += args[0];
 	else
 		*cpx = args[0];
 	nsvg__lineTo(p, *cpx, *cpy);
+	*cpx2 = *cpx;
+	*cpy2 = *cpy;
 }
 
-static void nsvg__pathVLineTo(NSVGparser* p, float* cpx, float* cpy, float* args, int rel)
+static void nsvg__pathVLineTo(NSVGparser* p, float* cpx, float* cpy,
+							  float* cpx2, float* cpy2, float* args, int rel)
 {
 	if (rel)
 		*cpy += args[0];
 	else
 		*cpy = args[0];
 	nsvg__lineTo(p, *cpx, *cpy);
+	*cpx2 = *cpx;
+	*cpy2 = *cpy;
 }
 
 static void nsvg__pathCubicBezTo(NSVGparser* p, float* cpx, float* cpy,
@@ -1980,7 +2146,8 @@ static float nsvg__vecang(float ux, float uy, float vx, float vy)
 	return ((ux*vy < uy*vx) ? -1.0f : 1.0f) * acosf(r);
 }
 
-static void nsvg__pathArcTo(NSVGparser* p, float* cpx, float* cpy, float* args, int rel)
+static void nsvg__pathArcTo(NSVGparser* p, float* cpx, float* cpy,
+							float* cpx2, float* cpy2, float* args, int rel)
 {
 	// Ported from canvg (https://code.google.com/p/canvg/)
 	float rx, ry, rotx;
@@ -2014,8 +2181,8 @@ static void nsvg__pathArcTo(NSVGparser* p, float* cpx, float* cpy, float* args,
 	if (d < 1e-6f || rx < 1e-6f || ry < 1e-6f) {
 		// The arc degenerates to a line
 		nsvg__lineTo(p, x2, y2);
-		*cpx = x2;
-		*cpy = y2;
+		*cpx2 = *cpx = x2;
+		*cpy2 = *cpy = y2;
 		return;
 	}
 
@@ -2095,22 +2262,61 @@ static void nsvg__pathArcTo(NSVGparser* p, float* cpx, float* cpy, float* args,
 		ptany = tany;
 	}
 
-	*cpx = x2;
-	*cpy = y2;
+	*cpx2 = *cpx = x2;
+	*cpy2 = *cpy = y2;
+}
+
+typedef void (*NSVGpathCommandFunc)(NSVGparser* p, float* cpx, float* cpy,
+									float* cpx2, float* cpy2, float* args, int rel);
+
+typedef struct NSVGpathCommand {
+	int nargs;
+	NSVGpathCommandFunc func;
+} NSVGpathCommand;
+
+// Path commands indexed by lower case letter, an upper case command is the absolute variant.
+static const NSVGpathCommand nsvg__pathCommands[26] = {
+	{ 7, nsvg__pathArcTo },				// a
+	{ 0, NULL },
+	{ 6, nsvg__pathCubicBezTo },		// c
+	{ 0, NULL }, { 0, NULL }, { 0, NULL }, { 0, NULL },
+	{ 1, nsvg__pathHLineTo },			// h
+	{ 0, NULL }, { 0, NULL }, { 0, NULL },
+	{ 2, nsvg__pathLineTo },			// l
+	{ 2, nsvg__pathMoveTo },			// m
+	{ 0, NULL }, { 0, NULL }, { 0, NULL },
+	{ 4, nsvg__pathQuadBezTo },			// q
+	{ 0, NULL },
+	{ 4, nsvg__pathCubicBezShortTo },	// s
+	{ 2, nsvg__pathQuadBezShortTo },	// t
+	{ 0, NULL },
+	{ 1, nsvg__pathVLineTo },			// v
+	{ 0, NULL }, { 0, NULL }, { 0, NULL },
+	{ 0, NULL },						// z, handled by the parser
+};
+
+static const NSVGpathCommand* nsvg__pathCommand(char cmd)
+{
+	static const NSVGpathCommand none = { 0, NULL };
+	char c = cmd | 0x20;
+	if (c < 'a' || c > 'z')
+		return &none;
+	return &nsvg__pathCommands[c - 'a'];
 }
 
 static void nsvg__parsePath(NSVGparser* p, const char** attr)
 {
 	const char* s = NULL;
+	const char* end;
 	char cmd = '\0';
+	const NSVGpathCommand* command = nsvg__pathCommand(cmd);
 	float args[10];
 	int nargs;
-	int rargs = 0;
 	float cpx, cpy, cpx2, cpy2;
 	const char* tmp[4];
 	char closedFlag;
+	char c;
 	int i;
-	char item[64];
 
 	for (i = 0; attr[i]; i += 2) {
 		if (strcmp(attr[i], "d") == 0) {
@@ -2131,72 +2337,41 @@ static void nsvg__parsePath(NSVGparser* p, const char** attr)
 		closedFlag = 0;
 		nargs = 0;
 
-		while (*s) {
-			s = nsvg__getNextPathItem(s, item);
-			if (!*item) break;
-			if (nsvg__isnum(item[0])) {
-				if (nargs < 10)
-					args[nargs++] = (float)atof(item);
-				if (nargs >= rargs) {
-					switch (cmd) {
-						case 'm':
-						case 'M':
-							nsvg__pathMoveTo(p, &cpx, &cpy, args, cmd == 'm' ? 1 : 0);
+		// Single pass over the path data, numbers are converted in place.
+		while ((c = *s) != '\0') {
+			if (c == ' ' || c == ',' || (c >= '\t' && c <= '\r')) {
+				s++;
+				continue;
+			}
+			if (nsvg__isdigit(c) || c == '-' || c == '+' || c == '.') {
+				if ((cmd == 'a' || cmd == 'A') && (nargs == 3 || nargs == 4) && (c == '0' || c == '1')) {
+					// Arc flags are single digits and need no separator, as in "a1 1 0 01 5 5".
+					args[nargs++] = (float)(c - '0');
+					s++;
+				} else {
+					end = nsvg__parseFloat(s, &args[nargs]);
+					if (end == s) {
+						s++;
+						continue;
+					}
+					s = end;
+					nargs++;
+				}
+				if (nargs >= command->nargs) {
+					if (command->func != NULL) {
+						command->func(p, &cpx, &cpy, &cpx2, &cpy2, args, cmd >= 'a');
+						if (cmd == 'm' || cmd == 'M') {
 							// Moveto can be followed by multiple coordinate pairs,
 							// which should be treated as linetos.
 							cmd = (cmd == 'm') ? 'l' : 'L';
-                            rargs = nsvg__getArgsPerElement(cmd);
-                            cpx2 = cpx; cpy2 = cpy;
-							break;
-						case 'l':
-						case 'L':
-							nsvg__pathLineTo(p, &cpx, &cpy, args, cmd == 'l' ? 1 : 0);
-                            cpx2 = cpx; cpy2 = cpy;
-							break;
-						case 'H':
-						case 'h':
-							nsvg__pathHLineTo(p, &cpx, &cpy, args, cmd == 'h' ? 1 : 0);
-                            cpx2 = cpx; cpy2 = cpy;
-							break;
-						case 'V':
-						case 'v':
-							nsvg__pathVLineTo(p, &cpx, &cpy, args, cmd == 'v' ? 1 : 0);
-                            cpx2 = cpx; cpy2 = cpy;
-							break;
-						case 'C':
-						case 'c':
-							nsvg__pathCubicBezTo(p, &cpx, &cpy, &cpx2, &cpy2, args, cmd == 'c' ? 1 : 0);
-							break;
-						case 'S':
-						case 's':
-							nsvg__pathCubicBezShortTo(p, &cpx, &cpy, &cpx2, &cpy2, args, cmd == 's' ? 1 : 0);
-							break;
-						case 'Q':
-						case 'q':
-							nsvg__pathQuadBezTo(p, &cpx, &cpy, &cpx2, &cpy2, args, cmd == 'q' ? 1 : 0);
-							break;
-						case 'T':
-						case 't':
-							nsvg__pathQuadBezShortTo(p, &cpx, &cpy, &cpx2, &cpy2, args, cmd == 't' ? 1 : 0);
-							break;
-						case 'A':
-						case 'a':
-							nsvg__pathArcTo(p, &cpx, &cpy, args, cmd == 'a' ? 1 : 0);
-                            cpx2 = cpx; cpy2 = cpy;
-							break;
-						default:
-							if (nargs >= 2) {
-								cpx = args[nargs-2];
-								cpy = args[nargs-1];
-	                            cpx2 = cpx; cpy2 = cpy;
-							}
-							break;
+							command = nsvg__pathCommand(cmd);
+						}
 					}
 					nargs = 0;
 				}
 			} else {
-				cmd = item[0];
-				rargs = nsvg__getArgsPerElement(cmd);
+				cmd = *s++;
+				command = nsvg__pathCommand(cmd);
 				if (cmd == 'M' || cmd == 'm') {
 					// Commit path.
 					if (p->npts > 0)
@@ -2380,9 +2555,9 @@ static void nsvg__parsePoly(NSVGparser* p, const char** attr, int closeFlag)
 {
 	int i;
 	const char* s;
+	const char* end;
 	float args[2];
 	int nargs, npts = 0;
-	char item[64];
 
 	nsvg__resetPath(p);
 
@@ -2392,8 +2567,14 @@ static void nsvg__parsePoly(NSVGparser* p, const char** attr, int closeFlag)
 				s = attr[i + 1];
 				nargs = 0;
 				while (*s) {
-					s = nsvg__getNextPathItem(s, item);
-					args[nargs++] = (float)atof(item);
+					end = nsvg__parseFloat(s, &args[nargs]);
+					if (end == s) {
+						// Separator or stray character.
+						s++;
+						continue;
+					}
+					s = end;
+					nargs++;
 					if (nargs >= 2) {
 						if (npts == 0)
 							nsvg__moveTo(p, args[0], args[1]);
@@ -2412,6 +2593,29 @@ static void nsvg__parsePoly(NSVGparser* p, const char** attr, int closeFlag)
 	nsvg__addShape(p);
 }
 
+static void nsvg__viewTransform(NSVGparser* p, const char* units, float* bounds);
+
+// Incremental parser: fold the view transform and the document transform into the root transform,
+// inherited by every element, so shape points are converted once when their path is added.
+static void nsvg__foldView(NSVGparser* p)
+{
+	NSVGattrib* root = nsvg__getAttr(p);
+	float t[6], us;
+
+	nsvg__viewTransform(p, p->units, NULL);
+	nsvg__xformIdentity(p->docXform);
+	if (p->viewCb != NULL) {
+		us = 1.0f / nsvg__convertToPixels(p, nsvg__coord(1.0f, nsvg__parseUnits(p->units)), 0.0f, 1.0f);
+		(*p->viewCb)(p->shapeUd, p->image->width * us, p->image->height * us, p->docXform);
+	}
+	nsvg__xformSetTranslation(t, p->viewTx, p->viewTy);
+	nsvg__xformMultiply(root->xform, t);
+	nsvg__xformSetScale(t, p->viewSx, p->viewSy);
+	nsvg__xformMultiply(root->xform, t);
+	nsvg__xformMultiply(root->xform, p->docXform);
+	p->viewFolded = 1;
+}
+
 static void nsvg__parseSVG(NSVGparser* p, const char** attr)
 {
 	int i;
@@ -2450,6 +2654,10 @@ static void nsvg__parseSVG(NSVGparser* p, const char** attr)
 			}
 		}
 	}
+
+	// The root element is parsed before any shape.
+	if (p->shapeCb != NULL && !p->viewFolded)
+		nsvg__foldView(p);
 }
 
 static void nsvg__parseGradient(NSVGparser* p, const char** attr, char type)
@@ -2564,65 +2772,132 @@ static void nsvg__parseGradientStop(NSVGparser* p, const char** attr)
 	stop->offset = curAttr->stopOffset;
 }
 
+enum NSVGelementName {
+	NSVG_ELEMENT_G = 0,
+	NSVG_ELEMENT_PATH,
+	NSVG_ELEMENT_RECT,
+	NSVG_ELEMENT_CIRCLE,
+	NSVG_ELEMENT_ELLIPSE,
+	NSVG_ELEMENT_LINE,
+	NSVG_ELEMENT_POLYLINE,
+	NSVG_ELEMENT_POLYGON,
+	NSVG_ELEMENT_LINEAR_GRADIENT,
+	NSVG_ELEMENT_RADIAL_GRADIENT,
+	NSVG_ELEMENT_STOP,
+	NSVG_ELEMENT_DEFS,
+	NSVG_ELEMENT_SVG,
+};
+
+static const char* nsvg__elementNames[] = {
+	"g",
+	"path",
+	"rect",
+	"circle",
+	"ellipse",
+	"line",
+	"polyline",
+	"polygon",
+	"linearGradient",
+	"radialGradient",
+	"stop",
+	"defs",
+	"svg",
+};
+
+// Perfect hash of nsvg__elementNames.
+static const unsigned char nsvg__elementHashDisp[4] = {
+	0, 1, 3, 1,
+};
+static const unsigned char nsvg__elementHashSlots[32] = {
+	0, 0, 10, 13, 0, 0, 0, 0, 6, 1, 0, 0, 0, 0, 0, 9,
+	0, 5, 3, 7, 12, 4, 8, 0, 0, 0, 11, 0, 2, 0, 0, 0,
+};
+
+static int nsvg__elementName(const char* el)
+{
+	size_t n = strlen(el);
+	int i = nsvg__hashKeyword(el, n, nsvg__elementHashDisp, 3, nsvg__elementHashSlots, 5);
+	return (i >= 0 && nsvg__isKeyword(nsvg__elementNames[i], el, n)) ? i : -1;
+}
+
 static void nsvg__startElement(void* ud, const char* el, const char** attr)
 {
 	NSVGparser* p = (NSVGparser*)ud;
+	int name = nsvg__elementName(el);
 
 	if (p->defsFlag) {
 		// Skip everything but gradients in defs
-		if (strcmp(el, "linearGradient") == 0) {
+		if (name == NSVG_ELEMENT_LINEAR_GRADIENT) {
 			nsvg__parseGradient(p, attr, NSVG_PAINT_LINEAR_GRADIENT);
-		} else if (strcmp(el, "radialGradient") == 0) {
+		} else if (name == NSVG_ELEMENT_RADIAL_GRADIENT) {
 			nsvg__parseGradient(p, attr, NSVG_PAINT_RADIAL_GRADIENT);
-		} else if (strcmp(el, "stop") == 0) {
+		} else if (name == NSVG_ELEMENT_STOP) {
 			nsvg__parseGradientStop(p, attr);
 		}
 		return;
 	}
 
-	if (strcmp(el, "g") == 0) {
+	// Content without an enclosing root element.
+	if (p->shapeCb != NULL && !p->viewFolded && name != NSVG_ELEMENT_SVG)
+		nsvg__foldView(p);
+
+	switch (name) {
+	case NSVG_ELEMENT_G:
 		nsvg__pushAttr(p);
 		nsvg__parseAttribs(p, attr);
-	} else if (strcmp(el, "path") == 0) {
+		break;
+	case NSVG_ELEMENT_PATH:
 		if (p->pathFlag)	// Do not allow nested paths.
 			return;
 		nsvg__pushAttr(p);
 		nsvg__parsePath(p, attr);
 		nsvg__popAttr(p);
-	} else if (strcmp(el, "rect") == 0) {
+		break;
+	case NSVG_ELEMENT_RECT:
 		nsvg__pushAttr(p);
 		nsvg__parseRect(p, attr);
 		nsvg__popAttr(p);
-	} else if (strcmp(el, "circle") == 0) {
+		break;
+	case NSVG_ELEMENT_CIRCLE:
 		nsvg__pushAttr(p);
 		nsvg__parseCircle(p, attr);
 		nsvg__popAttr(p);
-	} else if (strcmp(el, "ellipse") == 0) {
+		break;
+	case NSVG_ELEMENT_ELLIPSE:
 		nsvg__pushAttr(p);
 		nsvg__parseEllipse(p, attr);
 		nsvg__popAttr(p);
-	} else if (strcmp(el, "line") == 0)  {
+		break;
+	case NSVG_ELEMENT_LINE:
 		nsvg__pushAttr(p);
 		nsvg__parseLine(p, attr);
 		nsvg__popAttr(p);
-	} else if (strcmp(el, "polyline") == 0)  {
+		break;
+	case NSVG_ELEMENT_POLYLINE:
 		nsvg__pushAttr(p);
 		nsvg__parsePoly(p, attr, 0);
 		nsvg__popAttr(p);
-	} else if (strcmp(el, "polygon") == 0)  {
+		break;
+	case NSVG_ELEMENT_POLYGON:
 		nsvg__pushAttr(p);
 		nsvg__parsePoly(p, attr, 1);
 		nsvg__popAttr(p);
-	} else  if (strcmp(el, "linearGradient") == 0) {
+		break;
+	case NSVG_ELEMENT_LINEAR_GRADIENT:
 		nsvg__parseGradient(p, attr, NSVG_PAINT_LINEAR_GRADIENT);
-	} else if (strcmp(el, "radialGradient") == 0) {
+		break;
+	case NSVG_ELEMENT_RADIAL_GRADIENT:
 		nsvg__parseGradient(p, attr, NSVG_PAINT_RADIAL_GRADIENT);
-	} else if (strcmp(el, "stop") == 0) {
+		break;
+	case NSVG_ELEMENT_STOP:
 		nsvg__parseGradientStop(p, attr);
-	} else if (strcmp(el, "defs") == 0) {
+		break;
+	case NSVG_ELEMENT_DEFS:
 		p->defsFlag = 1;
-	} else if (strcmp(el, "svg") == 0) {
+		break;
+	case NSVG_ELEMENT_SVG:
 		nsvg__parseSVG(p, attr);
+		break;
 	}
 }
 
@@ -2630,12 +2905,16 @@ static void nsvg__endElement(void* ud, const char* el)
 {
 	NSVGparser* p = (NSVGparser*)ud;
 
-	if (strcmp(el, "g") == 0) {
+	switch (nsvg__elementName(el)) {
+	case NSVG_ELEMENT_G:
 		nsvg__popAttr(p);
-	} else if (strcmp(el, "path") == 0) {
+		break;
+	case NSVG_ELEMENT_PATH:
 		p->pathFlag = 0;
-	} else if (strcmp(el, "defs") == 0) {
+		break;
+	case NSVG_ELEMENT_DEFS:
 		p->defsFlag = 0;
+		break;
 	}
 }
 
@@ -2686,21 +2965,16 @@ static void nsvg__scaleGradient(NSVGgradient* grad, float tx, float ty, float sx
 	grad->xform[5] += ty*sx;
 }
 
-static void nsvg__scaleToViewbox(NSVGparser* p, const char* units)
+// Finds the transform from the viewBox to the units, bounds is NULL if the image bounds are unknown.
+static void nsvg__viewTransform(NSVGparser* p, const char* units, float* bounds)
 {
-	NSVGshape* shape;
-	NSVGpath* path;
-	float tx, ty, sx, sy, us, bounds[4], t[6], avgs;
-	int i;
-	float* pt;
+	float tx, ty, sx, sy, us;
 
 	// Guess image size if not set completely.
-	nsvg__imageBounds(p, bounds);
-
 	if (p->viewWidth == 0) {
 		if (p->image->width > 0) {
 			p->viewWidth = p->image->width;
-		} else {
+		} else if (bounds != NULL) {
 			p->viewMinx = bounds[0];
 			p->viewWidth = bounds[2] - bounds[0];
 		}
@@ -2708,7 +2982,7 @@ static void nsvg__scaleToViewbox(NSVGparser* p, const char* units)
 	if (p->viewHeight == 0) {
 		if (p->image->height > 0) {
 			p->viewHeight = p->image->height;
-		} else {
+		} else if (bounds != NULL) {
 			p->viewMiny = bounds[1];
 			p->viewHeight = bounds[3] - bounds[1];
 		}
@@ -2722,6 +2996,11 @@ static void nsvg__scaleToViewbox(NSVGparser* p, const char* units)
 	ty = -p->viewMiny;
 	sx = p->viewWidth > 0 ? p->image->width / p->viewWidth : 0;
 	sy = p->viewHeight > 0 ? p->image->height / p->viewHeight : 0;
+	if (bounds == NULL) {
+		// Size still unknown, keep user units.
+		if (p->viewWidth == 0) sx = 1;
+		if (p->viewHeight == 0) sy = 1;
+	}
 	// Unit scaling
 	us = 1.0f / nsvg__convertToPixels(p, nsvg__coord(1.0f, nsvg__parseUnits(units)), 0.0f, 1.0f);
 
@@ -2738,43 +3017,78 @@ static void nsvg__scaleToViewbox(NSVGparser* p, const char* units)
 		ty += nsvg__viewAlign(p->viewHeight*sy, p->image->height, p->alignY) / sy;
 	}
 
-	// Transform
-	sx *= us;
-	sy *= us;
-	avgs = (sx+sy) / 2.0f;
-	for (shape = p->image->shapes; shape != NULL; shape = shape->next) {
-		shape->bounds[0] = (shape->bounds[0] + tx) * sx;
-		shape->bounds[1] = (shape->bounds[1] + ty) * sy;
-		shape->bounds[2] = (shape->bounds[2] + tx) * sx;
-		shape->bounds[3] = (shape->bounds[3] + ty) * sy;
-		for (path = shape->paths; path != NULL; path = path->next) {
-			path->bounds[0] = (path->bounds[0] + tx) * sx;
-			path->bounds[1] = (path->bounds[1] + ty) * sy;
-			path->bounds[2] = (path->bounds[2] + tx) * sx;
-			path->bounds[3] = (path->bounds[3] + ty) * sy;
-			for (i =0; i < path->npts; i++) {
-				pt = &path->pts[i*2];
-				pt[0] = (pt[0] + tx) * sx;
-				pt[1] = (pt[1] + ty) * sy;
-			}
-		}
+	p->viewTx = tx;
+	p->viewTy = ty;
+	p->viewSx = sx * us;
+	p->viewSy = sy * us;
+}
 
-		if (shape->fill.type == NSVG_PAINT_LINEAR_GRADIENT || shape->fill.type == NSVG_PAINT_RADIAL_GRADIENT) {
-			nsvg__scaleGradient(shape->fill.gradient, tx,ty, sx,sy);
-			memcpy(t, shape->fill.gradient->xform, sizeof(float)*6);
-			nsvg__xformInverse(shape->fill.gradient->xform, t);
-		}
-		if (shape->stroke.type == NSVG_PAINT_LINEAR_GRADIENT || shape->stroke.type == NSVG_PAINT_RADIAL_GRADIENT) {
-			nsvg__scaleGradient(shape->stroke.gradient, tx,ty, sx,sy);
-			memcpy(t, shape->stroke.gradient->xform, sizeof(float)*6);
-			nsvg__xformInverse(shape->stroke.gradient->xform, t);
-		}
+// Gradients are built with the transform from paint to shape, they are used with its inverse.
+static void nsvg__invertGradients(NSVGshape* shape)
+{
+	float t[6];
+	if (shape->fill.type == NSVG_PAINT_LINEAR_GRADIENT || shape->fill.type == NSVG_PAINT_RADIAL_GRADIENT) {
+		memcpy(t, shape->fill.gradient->xform, sizeof(float)*6);
+		nsvg__xformInverse(shape->fill.gradient->xform, t);
+	}
+	if (shape->stroke.type == NSVG_PAINT_LINEAR_GRADIENT || shape->stroke.type == NSVG_PAINT_RADIAL_GRADIENT) {
+		memcpy(t, shape->stroke.gradient->xform, sizeof(float)*6);
+		nsvg__xformInverse(shape->stroke.gradient->xform, t);
+	}
+}
 
-		shape->strokeWidth *= avgs;
-		shape->strokeDashOffset *= avgs;
-		for (i = 0; i < shape->strokeDashCount; i++)
-			shape->strokeDashArray[i] *= avgs;
+static void nsvg__scaleShape(NSVGparser* p, NSVGshape* shape)
+{
+	NSVGpath* path;
+	float tx = p->viewTx, ty = p->viewTy, sx = p->viewSx, sy = p->viewSy;
+	float avgs = (sx+sy) / 2.0f;
+	int i;
+	float* pt;
+
+	shape->bounds[0] = (shape->bounds[0] + tx) * sx;
+	shape->bounds[1] = (shape->bounds[1] + ty) * sy;
+	shape->bounds[2] = (shape->bounds[2] + tx) * sx;
+	shape->bounds[3] = (shape->bounds[3] + ty) * sy;
+	for (path = shape->paths; path != NULL; path = path->next) {
+		path->bounds[0] = (path->bounds[0] + tx) * sx;
+		path->bounds[1] = (path->bounds[1] + ty) * sy;
+		path->bounds[2] = (path->bounds[2] + tx) * sx;
+		path->bounds[3] = (path->bounds[3] + ty) * sy;
+		for (i =0; i < path->npts; i++) {
+			pt = &path->pts[i*2];
+			pt[0] = (pt[0] + tx) * sx;
+			pt[1] = (pt[1] + ty) * sy;
+		}
 	}
+
+	if (shape->fill.type == NSVG_PAINT_LINEAR_GRADIENT || shape->fill.type == NSVG_PAINT_RADIAL_GRADIENT)
+		nsvg__scaleGradient(shape->fill.gradient, tx,ty, sx,sy);
+	if (shape->stroke.type == NSVG_PAINT_LINEAR_GRADIENT || shape->stroke.type == NSVG_PAINT_RADIAL_GRADIENT)
+		nsvg__scaleGradient(shape->stroke.gradient, tx,ty, sx,sy);
+	nsvg__invertGradients(shape);
+
+	shape->strokeWidth *= avgs;
+	shape->strokeDashOffset *= avgs;
+	for (i = 0; i < shape->strokeDashCount; i++)
+		shape->strokeDashArray[i] *= avgs;
+}
+
+static void nsvg__scaleToViewbox(NSVGparser* p, const char* units)
+{
+	NSVGshape* shape;
+	float bounds[4];
+
+	nsvg__imageBounds(p, bounds);
+	nsvg__viewTransform(p, units, bounds);
+	for (shape = p->image->shapes; shape != NULL; shape = shape->next)
+		nsvg__scaleShape(p, shape);
+}
+
+static void nsvg__streamShape(NSVGparser* p, NSVGshape* shape)
+{
+	// Points are final, converted by the folded root transform.
+	nsvg__invertGradients(shape);
+	(*p->shapeCb)(p->shapeUd, shape);
 }
 
 NSVGimage* nsvgParse(char* input, const char* units, float dpi)
@@ -2830,6 +3144,170 @@ error:
 	return NULL;
 }
 
+struct NSVGstream {
+	NSVGparser* parser;
+	char* buf;		// Copy of the tag being parsed, without '<' and '>'.
+	size_t len;
+	size_t cap;
+	char inTag;
+};
+
+NSVGstream* nsvgCreateStream(const char* units, float dpi,
+							 void (*viewCb)(void* ud, float width, float height, float* xform),
+							 void (*shapeCb)(void* ud, NSVGshape* shape), void* ud)
+{
+	NSVGstream* stream;
+
+	stream = (NSVGstream*)malloc(sizeof(NSVGstream));
+	if (stream == NULL) return NULL;
+	memset(stream, 0, sizeof(NSVGstream));
+
+	stream->parser = nsvg__createParser();
+	if (stream->parser == NULL) {
+		free(stream);
+		return NULL;
+	}
+	stream->parser->dpi = dpi;
+	stream->parser->viewCb = viewCb;
+	stream->parser->shapeCb = shapeCb;
+	stream->parser->shapeUd = ud;
+	strncpy(stream->parser->units, units, sizeof(stream->parser->units)-1);
+
+	return stream;
+}
+
+static int nsvg__streamAppend(NSVGstream* stream, const char* data, size_t size)
+{
+	// Keep room for the terminator.
+	if (stream->len + size + 1 > stream->cap) {
+		size_t cap = stream->cap > 0 ? stream->cap : 4096;
+		char* buf;
+		while (cap < stream->len + size + 1) cap *= 2;
+		buf = (char*)realloc(stream->buf, cap);
+		if (buf == NULL) return 0;
+		stream->buf = buf;
+		stream->cap = cap;
+	}
+	memcpy(stream->buf + stream->len, data, size);
+	stream->len += size;
+	return 1;
+}
+
+int nsvgStreamParse(NSVGstream* stream, const char* data, size_t size)
+{
+	const char* s = data;
+	const char* end = data + size;
+	const char* mark;
+
+	// Same states as nsvg__parseXML(), but the spans are found in place and only a complete tag is
+	// copied to be terminated and split. Content is skipped, the SVG parser does not use it.
+	while (s < end) {
+		if (!stream->inTag) {
+			mark = (const char*)memchr(s, '<', end - s);
+			if (mark == NULL)
+				break;
+			s = mark + 1;
+			stream->inTag = 1;
+			stream->len = 0;
+		} else {
+			mark = (const char*)memchr(s, '>', end - s);
+			if (!nsvg__streamAppend(stream, s, (mark != NULL ? mark : end) - s))
+				return 0;
+			if (mark == NULL)
+				break;
+			stream->buf[stream->len] = '\0';
+			nsvg__parseElement(stream->buf, nsvg__startElement, nsvg__endElement, stream->parser);
+			stream->inTag = 0;
+			s = mark + 1;
+		}
+	}
+
+	return 1;
+}
+
+void nsvgDeleteStream(NSVGstream* stream)
+{
+	if (stream == NULL) return;
+	nsvg__deleteParser(stream->parser);
+	free(stream->buf);
+	free(stream);
+}
+
+int nsvgParseFromFileStream(const char* filename, const char* units, float dpi,
+							void (*viewCb)(void* ud, float width, float height, float* xform),
+							void (*shapeCb)(void* ud, NSVGshape* shape), void* ud)
+{
+	FILE* fp = NULL;
+	NSVGstream* stream = NULL;
+	char data[65536];
+	size_t size;
+
+	stream = nsvgCreateStream(units, dpi, viewCb, shapeCb, ud);
+	if (stream == NULL) goto error;
+
+#ifdef NSVG_USE_MMAP
+	{
+		// Parse straight from the page cache.
+		struct stat st;
+		void* map;
+		int ok = 0;
+		int fd = open(filename, O_RDONLY);
+		if (fd < 0) goto error;
+		if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+			if (st.st_size == 0) {
+				ok = 1;
+			} else {
+				map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (map != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+					madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+					ok = nsvgStreamParse(stream, (const char*)map, (size_t)st.st_size) ? 1 : -1;
+					munmap(map, (size_t)st.st_size);
+				}
+			}
+		}
+		if (ok != 0) {
+			close(fd);
+			if (ok < 0) goto error;
+			nsvgDeleteStream(stream);
+			return 1;
+		}
+		// Not a regular file or mmap failed, read it instead.
+		fp = fdopen(fd, "rb");
+		if (!fp) {
+			close(fd);
+			goto error;
+		}
+	}
+#else
+	fp = fopen(filename, "rb");
+	if (!fp) goto error;
+#endif
+	while ((size = fread(data, 1, sizeof(data), fp)) > 0) {
+		if (!nsvgStreamParse(stream, data, size)) goto error;
+	}
+	if (ferror(fp)) goto error;
+	fclose(fp);
+	nsvgDeleteStream(stream);
+
+	return 1;
+
+error:
+	if (fp) fclose(fp);
+	if (stream) nsvgDeleteStream(stream);
+	return 0;
+}
+
+void nsvgDeleteShape(NSVGshape* shape)
+{
+	if (shape == NULL) return;
+	nsvg__deletePaths(shape->paths);
+	nsvg__deletePaint(&shape->fill);
+	nsvg__deletePaint(&shape->stroke);
+	free(shape);
+}
+
 void nsvgDelete(NSVGimage* image)
 {
 	NSVGshape *snext, *shape;
@@ -2837,10 +3315,7 @@ void nsvgDelete(NSVGimage* image)
 	shape = image->shapes;
 	while (shape != NULL) {
 		snext = shape->next;
-		nsvg__deletePaths(shape->paths);
-		nsvg__deletePaint(&shape->fill);
-		nsvg__deletePaint(&shape->stroke);
-		free(shape);
+		nsvgDeleteShape(shape);
 		shape = snext;
 	}
 	free(image);
@@ -30,16 +30,26 @@
  *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+#include<algorithm>
 #include<cmath>
 #include<cstring>
 #include<cstdio>
+#include<cstdlib>
+#include<deque>
+#include<map>
 #include<memory>
 #include<vector>
 #include<stdexcept>
 
+#ifdef SVG2EMB_USE_PTHREADS
+#include<pthread.h>
+#include<unistd.h>
+#endif
+
 #include<mathtransm.hxx>
 #include<cubicbezier.hxx>
 #include<embwrite.hxx>
+#include<tatamifill.hxx>
 
 
 /*
@@ -62,6 +72,32 @@
 
 static const float LINE_PITCH = 2.0;          /* mm */
 static const float TRIPLE_STITCH_WIDTH = 0.1; /* mm */
+static const float SATIN_WIDTH = 1.0;         /* mm */
+static const float SATIN_PITCH = 0.5;         /* mm, center line points */
+static const float SATIN_DENSITY = 0.15;      /* spacing in stroke width */
+static const float SATIN_MIN_SPACING = 0.3;   /* mm */
+static const float SATIN_MAX_SPACING = 0.5;   /* mm */
+static const float FILL_PITCH = 3.0;          /* mm */
+static const float FILL_ANGLE = 45.0;         /* degree */
+static const float FILL_SPACING = 0.4;        /* mm */
+static const float FILL_ROW_OFFSET = 1.0/3.0; /* in FILL_PITCH */
+static const float SVG_DPI = 90.0;            /* px per inch */
+
+
+/* thread catalogs for -t option */
+static const struct {
+  const char* name;
+  ThreadBrand brand;
+} THREAD_CATALOGS[] = {
+  { "hemingworth", Hemingworth_Polyester  },
+  { "isacord",     Isacord_Polyester      },
+  { "isafil",      Isafil_Rayon           },
+  { "pantone",     Pantone                },
+  { "robisonanton",RobisonAnton_Rayon     },
+  { "sigma",       Sigma_Polyester        },
+  { "sulky",       Sulky_Rayon            },
+  { "z102",        Z102_Isacord_Polyester },
+};
 
 
 
@@ -72,25 +108,91 @@ public:
               EmbroideryWriter& emb) const = 0;
 };
 
+/*
+ * nanosvg color (0xAABBGGRR) to 0xRRGGBB
+ */
+static unsigned int rgb_color(unsigned int c)
+{
+  return ((c&0xFF)<<16) | (c&0xFF00) | ((c>>16)&0xFF);
+}
+
+
 class SVGParserNormal : public SVGParser {
+private:
+  float fillangle;   /* radian */
+  float fillspacing;
+  float filloffset;
+
 public:
+  SVGParserNormal() :
+    fillangle(FILL_ANGLE*M_PI/180.0), fillspacing(FILL_SPACING),
+    filloffset(FILL_ROW_OFFSET)
+  {
+  }
+
+  /* angle in degree, row spacing in mm, row offset in FILL_PITCH */
+  void set_fill(float angle, float spacing, float offset)
+  {
+    fillangle = angle*M_PI/180.0;
+    fillspacing = spacing;
+    filloffset = offset;
+  }
+
   void parse_shape(const NSVGshape* shape, EmbroideryWriter& emb) const
   {
-    if( NSVG_PAINT_NONE!=shape->fill.type ){
-      /* TODO : implement filled shape */
+    if( NSVG_PAINT_COLOR==shape->fill.type ){
+      /* tatami fill, sewn before the outline */
+      emb.set_color(rgb_color(shape->fill.color));
+
+      TatamiFill fill(fillangle, fillspacing, FILL_PITCH, filloffset);
+      for(NSVGpath* path=shape->paths; NULL!=path; path=path->next){
+        fill.add_path(path->pts, path->npts);
+      }
+      std::vector<std::vector<math::vector2d> > rows
+        = fill.make_stitches(NSVG_FILLRULE_EVENODD==shape->fillRule);
+      for(size_t i=0; i<rows.size(); ++i){
+        emb.add_single_stitch(rows[i], FILL_PITCH, false, false);
+      }
+    }else if( NSVG_PAINT_NONE!=shape->fill.type ){
+      /* TODO : implement gradient fill */
     }
     if( NSVG_PAINT_COLOR==shape->stroke.type ){
-      /* Trace path */
-      for(NSVGpath* path=shape->paths; NULL!=path; path=path->next){
-        std::vector<math::vector2d> points
-          = EmbroideryWriter::make_points_on_bezier(path->pts, path->npts,
-                                                  LINE_PITCH);
-        if( TRIPLE_STITCH_WIDTH <= shape->strokeWidth ){
-          /* wide stroke => tipple stitch */
-          emb.add_tripple_stitch(points, LINE_PITCH, false, false);
-        }else{
-          /* narrow stroke => single stitch */
-          emb.add_single_stitch(points, LINE_PITCH, false, false);
+      emb.set_color(rgb_color(shape->stroke.color));
+
+      if( SATIN_WIDTH <= shape->strokeWidth ){
+        /* wide stroke => satin column, all paths at once */
+        std::vector<std::vector<math::vector2d> > columns;
+        for(NSVGpath* path=shape->paths; NULL!=path; path=path->next){
+          std::vector<std::vector<math::vector2d> > dashes
+            = EmbroideryWriter::make_dashes_on_bezier(path->pts, path->npts,
+                                                    SATIN_PITCH,
+                                                    shape->strokeDashArray,
+                                                    shape->strokeDashCount,
+                                                    shape->strokeDashOffset);
+          columns.insert(columns.end(), dashes.begin(), dashes.end());
+        }
+        float spacing = SATIN_DENSITY * shape->strokeWidth;
+        spacing = std::max(SATIN_MIN_SPACING,
+                           std::min(spacing, SATIN_MAX_SPACING));
+        emb.add_satin_stitch(columns, shape->strokeWidth, spacing);
+      }else{
+        /* Trace path, dashed stroke is stitched as separate segments */
+        for(NSVGpath* path=shape->paths; NULL!=path; path=path->next){
+          std::vector<std::vector<math::vector2d> > dashes
+            = EmbroideryWriter::make_dashes_on_bezier(path->pts, path->npts,
+                                                    LINE_PITCH,
+                                                    shape->strokeDashArray,
+                                                    shape->strokeDashCount,
+                                                    shape->strokeDashOffset);
+          for(size_t i=0; i<dashes.size(); ++i){
+            if( TRIPLE_STITCH_WIDTH <= shape->strokeWidth ){
+              /* wide stroke => tipple stitch */
+              emb.add_tripple_stitch(dashes[i], LINE_PITCH, false, false);
+            }else{
+              /* narrow stroke => single stitch */
+              emb.add_single_stitch(dashes[i], LINE_PITCH, false, false);
+            }
+          }
         }
       }
     }
@@ -134,31 +236,261 @@ public:
 /* ========================================================================= */
 
 
+struct ShapeSink {
+  const SVGParser* parser;
+  EmbroideryWriter* emb;
+};
+
+
 /*
- * Parse SVG, make stitches
+ * Transform of the whole document, called once the size is known
+ * Y axis of SVG is downward, of embroidery is upward, and the center
+ * of the page is placed on the origin (center of the hoop).
+ * nanosvg combines it with the unit conversion and shape transforms,
+ * so each point is transformed only once.
  */
-void
-parse_SVG(const char* filename, const SVGParser& parser, EmbroideryWriter& emb)
-  throw(std::runtime_error)
+static void document_cb(void* /* ud */, float width, float height, float* xform)
 {
-  /* read SVG */
-  struct NSVGimage* svg;
-  svg = nsvgParseFromFile(filename, "mm", 90);
-  if( NULL==svg ){
-    throw std::runtime_error("Can not read SVG file.");
+  const math::vector2d basis[2] = {
+    math::vector2d(1.0,  0.0),
+    math::vector2d(0.0, -1.0)
+  };
+  const math::transform_matrix<float,2>
+    doc(basis, math::vector2d(-0.5*width, 0.5*height));
+
+  /* to nanosvg matrix [ a b c d e f ] */
+  math::vector2d o  = doc*math::vector2d(0.0, 0.0);
+  math::vector2d ex = doc*math::vector2d(1.0, 0.0) - o;
+  math::vector2d ey = doc*math::vector2d(0.0, 1.0) - o;
+  xform[0] = ex[0];
+  xform[1] = ex[1];
+  xform[2] = ey[0];
+  xform[3] = ey[1];
+  xform[4] = o[0];
+  xform[5] = o[1];
+}
+
+
+/*
+ * Make stitches of a shape as soon as it is read, then release it
+ */
+static void parse_shape_cb(void* ud, NSVGshape* shape)
+{
+  const ShapeSink* sink = static_cast<const ShapeSink*>(ud);
+  if( NSVG_FLAGS_VISIBLE==shape->flags ){
+    sink->parser->parse_shape(shape, *sink->emb);
+  }else{
+    /* skip hidden shapes */
+  }
+  nsvgDeleteShape(shape);
+}
+
+
+#ifdef SVG2EMB_USE_PTHREADS
+
+/*
+ * Make stitches of shapes on worker threads
+ *
+ * Shapes are numbered as the SVG is read and queued for the workers.
+ * Each worker makes stitches of a shape into its own EmbroideryWriter,
+ * finished shapes are appended to the output in document order, so the
+ * result is same as the serial parse.
+ */
+class ShapeWorkers
+{
+private:
+  struct Job {
+    size_t seq;
+    NSVGshape* shape;
+  };
+
+  const SVGParser& parser;
+  EmbroideryWriter& emb;
+  std::vector<pthread_t> threads;
+  pthread_mutex_t mutex;
+  pthread_cond_t queued;   /* job queued or finishing */
+  pthread_cond_t merged;   /* shape appended to output */
+  std::deque<Job> jobs;
+  std::map<size_t, EmbroideryWriter*> done; /* finished out of order */
+  size_t nextseq;          /* number of next read shape */
+  size_t mergeseq;         /* number of next shape to append */
+  size_t maxpending;       /* read but not yet appended shapes */
+  bool finishing;
+  bool failed;
+
+  static void* run(void* arg)
+  {
+    static_cast<ShapeWorkers*>(arg)->work();
+    return NULL;
+  }
+
+  void work()
+  {
+    pthread_mutex_lock(&mutex);
+    for(;;){
+      while( jobs.empty() && !finishing ){
+        pthread_cond_wait(&queued, &mutex);
+      }
+      if( jobs.empty() ){
+        break;
+      }
+      Job job = jobs.front();
+      jobs.pop_front();
+      pthread_mutex_unlock(&mutex);
+
+      /* make stitches without lock */
+      EmbroideryWriter* local = NULL;
+      try{
+        local = new EmbroideryWriter();
+        parser.parse_shape(job.shape, *local);
+      }catch(...){
+        delete local;
+        local = NULL;
+      }
+      nsvgDeleteShape(job.shape);
+
+      pthread_mutex_lock(&mutex);
+      if( NULL==local ){
+        failed = true;
+      }
+      done[job.seq] = local;
+
+      /* append shapes ready in document order */
+      std::map<size_t, EmbroideryWriter*>::iterator it;
+      while( !done.empty() && (it=done.begin())->first==mergeseq ){
+        if( NULL!=it->second ){
+          emb.append(*it->second);
+          delete it->second;
+        }
+        done.erase(it);
+        ++mergeseq;
+        pthread_cond_signal(&merged);
+      }
+    }
+    pthread_mutex_unlock(&mutex);
+  }
+
+public:
+  ShapeWorkers(const SVGParser& svgparser, EmbroideryWriter& output,
+               int nthreads) :
+    parser(svgparser), emb(output),
+    nextseq(0), mergeseq(0), maxpending(64*nthreads),
+    finishing(false), failed(false)
+  {
+    pthread_mutex_init(&mutex, NULL);
+    pthread_cond_init(&queued, NULL);
+    pthread_cond_init(&merged, NULL);
+    for(int i=0; i<nthreads; ++i){
+      pthread_t thread;
+      if( 0==pthread_create(&thread, NULL, run, this) ){
+        threads.push_back(thread);
+      }
+    }
   }
 
-  /* parse SVG */
-  for(NSVGshape* shape=svg->shapes; NULL!=shape; shape=shape->next){
-    if( NSVG_FLAGS_VISIBLE!=shape->flags ){
+  ~ShapeWorkers()
+  {
+    finish();
+    pthread_cond_destroy(&merged);
+    pthread_cond_destroy(&queued);
+    pthread_mutex_destroy(&mutex);
+  }
+
+  bool is_running() const
+  {
+    return !threads.empty();
+  }
+
+  /* queue shape, wait while too many shapes are pending */
+  void push(NSVGshape* shape)
+  {
+    pthread_mutex_lock(&mutex);
+    while( maxpending <= nextseq-mergeseq ){
+      pthread_cond_wait(&merged, &mutex);
+    }
+    Job job = { nextseq++, shape };
+    jobs.push_back(job);
+    pthread_cond_signal(&queued);
+    pthread_mutex_unlock(&mutex);
+  }
+
+  /* wait for all queued shapes, returns false if any shape failed */
+  bool finish()
+  {
+    pthread_mutex_lock(&mutex);
+    finishing = true;
+    pthread_cond_broadcast(&queued);
+    pthread_mutex_unlock(&mutex);
+    for(size_t i=0; i<threads.size(); ++i){
+      pthread_join(threads[i], NULL);
+    }
+    threads.clear();
+    return !failed;
+  }
+
+  static void push_cb(void* ud, NSVGshape* shape)
+  {
+    if( NSVG_FLAGS_VISIBLE==shape->flags ){
+      static_cast<ShapeWorkers*>(ud)->push(shape);
+    }else{
       /* skip hidden shapes */
-      continue;
+      nsvgDeleteShape(shape);
+    }
+  }
+};
+
+
+/*
+ * Number of online processors
+ */
+static int count_processors()
+{
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return (1<=n) ? (int)n : 1;
+}
+
+#else
+
+static int count_processors()
+{
+  return 1;
+}
+
+#endif
+
+
+/*
+ * Parse SVG, make stitches
+ */
+void
+parse_SVG(const char* filename, const SVGParser& parser, EmbroideryWriter& emb,
+          float dpi, int nthreads)
+  throw(std::runtime_error)
+{
+#ifdef SVG2EMB_USE_PTHREADS
+  if( 1<nthreads ){
+    ShapeWorkers workers(parser, emb, nthreads);
+    if( workers.is_running() ){
+      /* read SVG in chunks, shapes are stitched on worker threads */
+      if( ! nsvgParseFromFileStream(filename, "mm", dpi, document_cb,
+                                    ShapeWorkers::push_cb, &workers) ){
+        workers.finish();
+        throw std::runtime_error("Can not read SVG file.");
+      }
+      if( ! workers.finish() ){
+        throw std::runtime_error("Can not make stitches.");
+      }
+      return;
     }
-    parser.parse_shape(shape, emb);
   }
+#endif
 
-  /* relase SVG */
-  nsvgDelete(svg);
+  /* read SVG in chunks, only one shape is kept at a time */
+  ShapeSink sink = { &parser, &emb };
+  if( ! nsvgParseFromFileStream(filename, "mm", dpi, document_cb,
+                                parse_shape_cb, &sink) ){
+    throw std::runtime_error("Can not read SVG file.");
+  }
 }
 
 
@@ -167,7 +499,20 @@ parse_SVG(const char* filename, const SVGParser& parser, EmbroideryWriter& emb)
  */
 void print_help()
 {
-  fputs("svg2emb [-m normal|fritzing09] INPUT.svg OUTPUT.pes\n", stderr);
+  fputs("svg2emb [-m normal|fritzing09] [-t CATALOG] [-j THREADS]"
+        " [-a ANGLE] [-d SPACING] [-r OFFSET] [--dpi DPI]"
+        " INPUT.svg OUTPUT.pes\n", stderr);
+  fputs("  CATALOG :", stderr);
+  for(size_t i=0; i<sizeof(THREAD_CATALOGS)/sizeof(THREAD_CATALOGS[0]); ++i){
+    fprintf(stderr, " %s", THREAD_CATALOGS[i].name);
+  }
+  fputs("\n", stderr);
+  fputs("  ANGLE   : direction of fill rows in degree, counterclockwise\n",
+        stderr);
+  fputs("  SPACING : distance between fill rows in mm\n", stderr);
+  fputs("  OFFSET  : shift of fill stitches on next row,"
+        " in stitch length\n", stderr);
+  fputs("  DPI     : resolution of px units, 90 by default\n", stderr);
 }
 
 
@@ -181,6 +526,12 @@ int main(int argc, char* argv[])
   SVGParser* svg_parser = &parser_normal;
   const char* svgfile = NULL;
   const char* outfile = NULL;
+  const char* catalog = NULL;
+  int nthreads = count_processors();
+  float fillangle = FILL_ANGLE;
+  float fillspacing = FILL_SPACING;
+  float filloffset = FILL_ROW_OFFSET;
+  float dpi = SVG_DPI;
 
   /* parse commandline */
   for(int i=1; i<argc; ++i){
@@ -195,7 +546,54 @@ int main(int argc, char* argv[])
           }
         }
         break;
-      defaults:
+      case 't': /* -t : thread catalog */
+        if( ++i < argc ){
+          catalog = argv[i];
+        }
+        break;
+      case 'j': /* -j : number of threads making stitches */
+        if( ++i < argc ){
+          nthreads = atoi(argv[i]);
+          if( 1>nthreads ){
+            nthreads = 1;
+          }
+        }
+        break;
+      case 'a': /* -a : fill angle */
+        if( ++i < argc ){
+          fillangle = atof(argv[i]);
+        }
+        break;
+      case 'd': /* -d : fill row spacing */
+        if( ++i < argc ){
+          fillspacing = atof(argv[i]);
+          if( 0.0>=fillspacing ){
+            fputs("Fill row spacing must be positive\n\n", stderr);
+            print_help();
+            return -1;
+          }
+        }
+        break;
+      case 'r': /* -r : fill row offset */
+        if( ++i < argc ){
+          filloffset = atof(argv[i]);
+        }
+        break;
+      case '-':
+        if( 0==strcmp(argv[i], "--dpi") ){
+          /* --dpi : resolution of px units */
+          if( ++i < argc ){
+            dpi = atof(argv[i]);
+            if( 0.0>=dpi ){
+              fputs("DPI must be positive\n\n", stderr);
+              print_help();
+              return -1;
+            }
+          }
+          break;
+        }
+        /* fall through */
+      default:
         /* Unknown option */
         fprintf(stderr, "Unknown option \"%s\"\n\n", argv[i]);
         print_help();
@@ -221,9 +619,25 @@ int main(int argc, char* argv[])
     return -1;
   }
 
+  parser_normal.set_fill(fillangle, fillspacing, filloffset);
+
   try{
     EmbroideryWriter emb;
-    parse_SVG(svgfile, *svg_parser, emb);
+    if( NULL!=catalog ){
+      size_t i;
+      for(i=0; i<sizeof(THREAD_CATALOGS)/sizeof(THREAD_CATALOGS[0]); ++i){
+        if( 0==strcasecmp(catalog, THREAD_CATALOGS[i].name) ){
+          emb.set_thread_catalog(THREAD_CATALOGS[i].brand);
+          break;
+        }
+      }
+      if( i==sizeof(THREAD_CATALOGS)/sizeof(THREAD_CATALOGS[0]) ){
+        fprintf(stderr, "Unknown thread catalog \"%s\"\n\n", catalog);
+        print_help();
+        return -1;
+      }
+    }
+    parse_SVG(svgfile, *svg_parser, emb, dpi, nthreads);
     if( emb.is_empty() ){
       fputs("Empty SVG.\n", stdout);
       return 1;
@@ -0,0 +1,495 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * Copyright (c) 2016, Hanabusa Masahiro All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ * 3.  The name of the author may not be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISE OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ( BSD license without advertising clause )
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include<tatamifill.hxx>
+#include<algorithm>
+#include<cmath>
+#include<deque>
+#include<utility>
+#include<vector>
+
+
+static const float FLATNESS = 0.05;       /* mm, max distance from curve */
+static const int MAX_CURVE_LINES = 256;   /* lines per Bezier segment */
+static const float MIN_STITCH = 0.25;     /* in stitch length */
+
+
+/*
+ * Order edges by start row
+ */
+static bool edge_less(const std::pair<float,int>& a,
+                      const std::pair<float,int>& b)
+{
+  return a.first < b.first;
+}
+
+
+/* ========================================================================= */
+/*  Implementation  of  TatamiFill                                           */
+/* ========================================================================= */
+
+/*
+ * Constructor
+ *   angle        : direction of rows (radian)
+ *   rowspacing   : distance between rows
+ *   stitchlength : length of stitches in a row
+ *   offset       : shift of stitches on next row, in stitch length
+ */
+TatamiFill::TatamiFill(float angle, float rowspacing, float stitchlength,
+                       float offset) :
+  spacing(rowspacing), pitch(stitchlength), rowoffset(offset)
+{
+  math::vector2d tofillbasis[2] = {
+    math::vector2d( cos(angle), -sin(angle) ),
+    math::vector2d( sin(angle),  cos(angle) )
+  };
+  math::vector2d toshapebasis[2] = {
+    math::vector2d( cos(angle),  sin(angle) ),
+    math::vector2d(-sin(angle),  cos(angle) )
+  };
+  tofill  = math::transform_matrix<float,2>(tofillbasis,  math::vector2d());
+  toshape = math::transform_matrix<float,2>(toshapebasis, math::vector2d());
+}
+
+
+/*
+ * Add edge a-b of outline (in fill coordinates)
+ */
+void TatamiFill::add_edge(const math::vector2d& a, const math::vector2d& b)
+{
+  if( a[1]==b[1] ){
+    /* parallel to rows, never crossed */
+    return;
+  }
+
+  Edge e;
+  if( a[1] < b[1] ){
+    e.ymin = a[1];  e.ymax = b[1];  e.x = a[0];  e.winding = 1;
+  }else{
+    e.ymin = b[1];  e.ymax = a[1];  e.x = b[0];  e.winding = -1;
+  }
+  e.dxdy = (b[0]-a[0]) / (b[1]-a[1]);
+  edges.push_back(e);
+}
+
+
+/*
+ * Add outline of shape, path is closed if it is not
+ */
+void TatamiFill::add_path(const float* bezierpts, int npts)
+{
+  if( 2>npts ){
+    return;
+  }
+
+  math::vector2d first = tofill * math::vector2d(&bezierpts[0]);
+  math::vector2d last = first;
+
+  for(int i=0; i<npts-1; i+=3) {
+    math::vector2d p0(&bezierpts[i*2  ]);
+    math::vector2d p1(&bezierpts[i*2+2]);
+    math::vector2d p2(&bezierpts[i*2+4]);
+    math::vector2d p3(&bezierpts[i*2+6]);
+
+    /* number of lines within FLATNESS, from bound of 2nd derivative */
+    float dd = std::max( (p0 - 2.0f*p1 + p2).norm(),
+                         (p1 - 2.0f*p2 + p3).norm() );
+    int n = (int)ceil( sqrt(0.75*dd/FLATNESS) );
+    n = std::min( std::max(n, 1), MAX_CURVE_LINES );
+
+    for(int j=1; j<=n; ++j){
+      float t = (float)j / n;
+      math::vector2d pt
+        = (     (1.0f-t)*(1.0f-t)*(1.0f-t) ) * p0
+        +    ( 3.0f*(1.0f-t)*(1.0f-t)*  t  ) * p1
+        +    ( 3.0f*(1.0f-t)*     t *   t  ) * p2
+        +    (          t *     t *     t  ) * p3;
+      math::vector2d v = tofill * pt;
+      add_edge(last, v);
+      last = v;
+    }
+  }
+
+  /* close outline */
+  add_edge(last, first);
+}
+
+
+/*
+ * Sweep rows over edges, find parts of rows inside the shape
+ *
+ * Edges are sorted by start row once. An active edge table holds edges
+ * crossing current row, edges enter when the sweep reaches their start
+ * and leave after their end, so each row visits only crossing edges.
+ */
+std::vector<TatamiFill::Span> TatamiFill::make_spans(bool evenodd) const
+{
+  std::vector<Span> spans;
+  if( edges.empty() ){
+    return spans;
+  }
+
+  /* edge table sorted by ymin */
+  std::vector< std::pair<float,int> > table;
+  table.reserve(edges.size());
+  float ymax = edges[0].ymax;
+  for(size_t i=0; i<edges.size(); ++i){
+    table.push_back(std::pair<float,int>(edges[i].ymin, (int)i));
+    ymax = std::max(ymax, edges[i].ymax);
+  }
+  std::sort(table.begin(), table.end(), edge_less);
+
+  std::vector<int> active;
+  std::vector< std::pair<float,int> > crossings; /* x, winding */
+  size_t next = 0;
+  int lastrow = (int)floor(ymax / spacing);
+
+  for(int row=(int)ceil(table[0].first / spacing); row<=lastrow; ++row){
+    float y = row * spacing;
+
+    /* edges starting at or before this row */
+    while( next<table.size() && table[next].first <= y ){
+      active.push_back(table[next++].second);
+    }
+
+    /* drop ended edges, cross others */
+    crossings.clear();
+    for(size_t a=0; a<active.size(); ){
+      const Edge& e = edges[active[a]];
+      if( e.ymax <= y ){
+        active[a] = active.back();
+        active.pop_back();
+        continue;
+      }
+      crossings.push_back(
+        std::pair<float,int>(e.x + (y-e.ymin)*e.dxdy, e.winding) );
+      ++a;
+    }
+    std::sort(crossings.begin(), crossings.end());
+
+    /* inside by fill rule */
+    int wind = 0;
+    Span span;
+    span.row = row;
+    span.x0 = 0.0;
+    for(size_t c=0; c<crossings.size(); ++c){
+      int before = wind;
+      wind = evenodd ? (wind ^ 1) : (wind + crossings[c].second);
+      if( 0==before && 0!=wind ){
+        span.x0 = crossings[c].first;
+      }else if( 0!=before && 0==wind ){
+        span.x1 = crossings[c].first;
+        if( span.x0 < span.x1 ){
+          spans.push_back(span);
+        }
+      }
+    }
+  }
+
+  return spans;
+}
+
+
+/*
+ * Stitches of a row, needle points are on a grid shifted for each row
+ */
+void TatamiFill::make_row_stitches(const Span& span, bool reverse,
+                                   std::vector<math::vector2d>& points) const
+{
+  float y = span.row * spacing;
+  float phase = fmod(span.row * rowoffset, 1.0f);
+  if( 0.0>phase ){
+    phase += 1.0;
+  }
+
+  /* grid points not too close to ends */
+  int first = (int)ceil ( (span.x0 + MIN_STITCH*pitch)/pitch - phase );
+  int last  = (int)floor( (span.x1 - MIN_STITCH*pitch)/pitch - phase );
+
+  if( !reverse ){
+    points.push_back( toshape * math::vector2d(span.x0, y) );
+    for(int j=first; j<=last; ++j){
+      points.push_back( toshape * math::vector2d((j+phase)*pitch, y) );
+    }
+    points.push_back( toshape * math::vector2d(span.x1, y) );
+  }else{
+    points.push_back( toshape * math::vector2d(span.x1, y) );
+    for(int j=last; j>=first; --j){
+      points.push_back( toshape * math::vector2d((j+phase)*pitch, y) );
+    }
+    points.push_back( toshape * math::vector2d(span.x0, y) );
+  }
+}
+
+
+/*
+ * Group spans into cells
+ *
+ * A span continues the cell of the span above when they only overlap
+ * each other. Where rows split around a hole or merge below it, new
+ * cells start and are linked to the cells they touch.
+ */
+std::vector<TatamiFill::Cell>
+TatamiFill::make_cells(const std::vector<Span>& spans,
+                       std::vector<int>& spancell) const
+{
+  std::vector<Cell> cells;
+  std::vector<int> up(spans.size(), 0);      /* overlapping spans above */
+  std::vector<int> down(spans.size(), 0);    /* overlapping spans below */
+  std::vector<int> above(spans.size(), -1);  /* an overlapping span above */
+  std::vector< std::pair<int,int> > touches; /* overlapping span pairs */
+
+  /* overlaps of consecutive rows, spans of a row are sorted by x */
+  size_t prevbegin = 0;
+  size_t prevend = 0;
+  for(size_t begin=0; begin<spans.size(); ){
+    size_t end = begin;
+    while( end<spans.size() && spans[end].row==spans[begin].row ){
+      ++end;
+    }
+    if( prevbegin<prevend && spans[prevbegin].row+1==spans[begin].row ){
+      size_t a = prevbegin;
+      size_t b = begin;
+      while( a<prevend && b<end ){
+        if( spans[a].x0 < spans[b].x1 && spans[b].x0 < spans[a].x1 ){
+          touches.push_back(std::pair<int,int>((int)a, (int)b));
+          ++down[a];
+          ++up[b];
+          above[b] = (int)a;
+        }
+        /* next span after the one ending first */
+        if( spans[a].x1 < spans[b].x1 ){
+          ++a;
+        }else{
+          ++b;
+        }
+      }
+    }
+    prevbegin = begin;
+    prevend = end;
+    begin = end;
+  }
+
+  spancell.assign(spans.size(), -1);
+  for(size_t i=0; i<spans.size(); ++i){
+    int a = above[i];
+    if( 1==up[i] && 1==down[a] ){
+      spancell[i] = spancell[a];
+    }else{
+      spancell[i] = (int)cells.size();
+      cells.push_back(Cell());
+    }
+    cells[spancell[i]].spans.push_back((int)i);
+  }
+
+  for(size_t i=0; i<touches.size(); ++i){
+    int a = touches[i].first;
+    int b = touches[i].second;
+    if( spancell[a]!=spancell[b] ){
+      Link down = { spancell[b], a, b };
+      Link up   = { spancell[a], b, a };
+      cells[spancell[a]].links.push_back(down);
+      cells[spancell[b]].links.push_back(up);
+    }
+  }
+
+  return cells;
+}
+
+
+/*
+ * Running stitches along path (fill coordinates) from its first point
+ */
+void TatamiFill::add_travel(const std::vector<math::vector2d>& path,
+                            std::vector<math::vector2d>& points) const
+{
+  if( 2>path.size() ){
+    return;
+  }
+
+  float left = pitch; /* distance to next stitch */
+  for(size_t i=1; i<path.size(); ++i){
+    math::vector2d d = path[i] - path[i-1];
+    float len = d.norm();
+    float at = 0.0;
+    while( left < len-at ){
+      at += left;
+      points.push_back( toshape * (path[i-1] + d*(at/len)) );
+      left = pitch;
+    }
+    left -= len-at;
+  }
+  points.push_back( toshape * path.back() );
+}
+
+
+/*
+ * Make fill stitches
+ *
+ * Each cell is sewn back and forth from the end it is entered. Then the
+ * nearest cell not sewn yet is searched through linked cells, and the
+ * needle runs there along the side of the cells in between. Only shapes
+ * in separate pieces need more than one stitch segment.
+ */
+std::vector<std::vector<math::vector2d> >
+TatamiFill::make_stitches(bool evenodd) const
+{
+  std::vector<std::vector<math::vector2d> > segments;
+  std::vector<Span> spans = make_spans(evenodd);
+  std::vector<int> spancell;
+  std::vector<Cell> cells = make_cells(spans, spancell);
+  if( cells.empty() ){
+    return segments;
+  }
+
+  std::vector<bool> sewn(cells.size(), false);
+  std::vector<int> prevcell(cells.size());
+  std::vector<const Link*> via(cells.size());
+  std::vector<math::vector2d> points;
+  std::vector<math::vector2d> path;
+  std::deque<int> queue;
+
+  int cell = 0;
+  int entry = cells[0].spans.front();
+  math::vector2d pos(spans[entry].x0, spans[entry].row*spacing);
+
+  for(;;){
+    /* sew cell from entry row, starting at the end of row nearer pos */
+    const Cell& c = cells[cell];
+    bool fromtop = ( entry==c.spans.front() );
+    bool reverse = ( fabs(pos[0]-spans[entry].x1)
+                     < fabs(pos[0]-spans[entry].x0) );
+    for(size_t k=0; k<c.spans.size(); ++k){
+      const Span& span = spans[ c.spans[fromtop ? k : c.spans.size()-1-k] ];
+      make_row_stitches(span, reverse, points);
+      reverse = !reverse;
+    }
+    sewn[cell] = true;
+    int at = fromtop ? c.spans.back() : c.spans.front();
+    pos = math::vector2d(reverse ? spans[at].x1 : spans[at].x0,
+                         spans[at].row*spacing);
+
+    /* nearest cell not sewn, through linked cells */
+    int found = -1;
+    prevcell.assign(cells.size(), -1);
+    prevcell[cell] = cell;
+    queue.clear();
+    queue.push_back(cell);
+    while( !queue.empty() && 0>found ){
+      int q = queue.front();
+      queue.pop_front();
+      for(size_t l=0; l<cells[q].links.size(); ++l){
+        const Link& link = cells[q].links[l];
+        if( 0<=prevcell[link.cell] ){
+          continue;
+        }
+        prevcell[link.cell] = q;
+        via[link.cell] = &link;
+        if( !sewn[link.cell] ){
+          found = link.cell;
+          break;
+        }
+        queue.push_back(link.cell);
+      }
+    }
+
+    if( 0<=found ){
+      /* links from current cell to found cell */
+      std::vector<const Link*> route;
+      for(int r=found; r!=cell; r=prevcell[r]){
+        route.push_back(via[r]);
+      }
+
+      /* run along the side of cells on the way */
+      bool left = ( pos[0]==spans[at].x0 );
+      path.clear();
+      path.push_back(pos);
+      for(size_t r=route.size(); 0<r--; ){
+        const Link& link = *route[r];
+        const Cell& through = cells[spancell[at]];
+        int top = spans[through.spans.front()].row;
+        int k = spans[at].row - top;
+        int kend = spans[link.from].row - top;
+        while( k!=kend ){
+          k += (k<kend) ? 1 : -1;
+          const Span& span = spans[through.spans[k]];
+          path.push_back(math::vector2d(left ? span.x0 : span.x1,
+                                        span.row*spacing));
+        }
+        at = link.to;
+        path.push_back(math::vector2d(left ? spans[at].x0 : spans[at].x1,
+                                      spans[at].row*spacing));
+      }
+      add_travel(path, points);
+
+      cell = found;
+      entry = at;
+      pos = path.back();
+    }else{
+      /* separate piece of shape, jump to the nearest end of a cell */
+      segments.push_back(points);
+      points.clear();
+
+      float mindist = -1.0;
+      math::vector2d start;
+      for(size_t i=0; i<cells.size(); ++i){
+        if( sewn[i] ){
+          continue;
+        }
+        int ends[2] = { cells[i].spans.front(), cells[i].spans.back() };
+        for(int e=0; e<2; ++e){
+          const Span& span = spans[ends[e]];
+          math::vector2d corners[2] = {
+            math::vector2d(span.x0, span.row*spacing),
+            math::vector2d(span.x1, span.row*spacing)
+          };
+          for(int j=0; j<2; ++j){
+            float dist = (corners[j]-pos).square_norm();
+            if( 0.0>mindist || dist<mindist ){
+              mindist = dist;
+              start = corners[j];
+              cell = (int)i;
+              entry = ends[e];
+            }
+          }
+        }
+      }
+      if( 0.0>mindist ){
+        /* all cells are sewn */
+        break;
+      }
+      pos = start;
+    }
+  }
+
+  return segments;
+}
@@ -0,0 +1,116 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * Copyright (c) 2016, Hanabusa Masahiro All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ * 3.  The name of the author may not be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISE OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ( BSD license without advertising clause )
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _TATAMIFILL_HXX
+#define _TATAMIFILL_HXX 1
+
+#include<vector>
+
+#include<mathtransm.hxx>
+
+
+/*
+ * Tatami fill stitches of a filled shape
+ *
+ * Outlines are flattened to polygons and filled row by row. Rows are
+ * parallel lines at fill angle, spaced by row spacing. Stitches in a row
+ * are placed at stitch length, and every row shifts them by row offset
+ * (a fraction of stitch length) to spread needle points as tatami.
+ *
+ * Rows are found by a scanline sweep with an active edge table, edges
+ * are sorted once and each row only visits edges crossing it.
+ *
+ * Rows are grouped into cells where each row overlaps exactly one row
+ * above and below. A cell is sewn back and forth in one run, and cells
+ * are visited through the graph of touching cells. Moves between cells
+ * are running stitches along the outline, so a connected shape needs no
+ * trim.
+ */
+class TatamiFill
+{
+private:
+  /* polygon edge in fill coordinates (rows are horizontal) */
+  struct Edge {
+    float ymin;
+    float ymax;
+    float x;       /* x at ymin */
+    float dxdy;
+    int winding;   /* +1 upward, -1 downward */
+  };
+
+  /* part of a row inside the shape */
+  struct Span {
+    int row;
+    float x0;
+    float x1;
+  };
+
+  /* touching span of other cell */
+  struct Link {
+    int cell;
+    int from;      /* span in this cell */
+    int to;        /* span in other cell */
+  };
+
+  /* rows sewn in one run, each overlaps only its neighbour rows */
+  struct Cell {
+    std::vector<int> spans;   /* from top to bottom */
+    std::vector<Link> links;
+  };
+
+  float spacing;
+  float pitch;
+  float rowoffset;
+  math::transform_matrix<float,2> tofill;   /* shape => fill coordinates */
+  math::transform_matrix<float,2> toshape;  /* fill => shape coordinates */
+  std::vector<Edge> edges;
+
+  void add_edge(const math::vector2d& a, const math::vector2d& b);
+  std::vector<Span> make_spans(bool evenodd) const;
+  std::vector<Cell> make_cells(const std::vector<Span>& spans,
+                               std::vector<int>& spancell) const;
+  void make_row_stitches(const Span& span, bool reverse,
+                         std::vector<math::vector2d>& points) const;
+  void add_travel(const std::vector<math::vector2d>& path,
+                  std::vector<math::vector2d>& points) const;
+
+public:
+  TatamiFill(float angle, float rowspacing, float stitchlength,
+             float offset);
+
+  void add_path(const float* bezierpts, int npts);
+  std::vector<std::vector<math::vector2d> > make_stitches(bool evenodd) const;
+
+}; /* end of class TatamiFill */
+
+
+#endif